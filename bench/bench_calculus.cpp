@@ -0,0 +1,81 @@
+#include <cmath>
+#include <memory>
+
+#include "benchmarks.hpp"
+
+#include "mathlib/calculus/diff.hpp"
+#include "mathlib/calculus/grad.hpp"
+#include "mathlib/calculus/integrate.hpp"
+#include "mathlib/calculus/root.hpp"
+
+namespace mathlib::bench {
+    namespace {
+
+        // Counter shared between a benchmark body and its evals reader
+        using counter = std::shared_ptr<std::size_t>;
+
+        template <typename T>
+        void register_type(Runner& r) {
+            {
+                counter n = std::make_shared<std::size_t>(0);
+                auto f = [n](T x) { ++*n; return std::sin(x) * std::exp(-x / 4); };
+                r.add(label<T>("derivative"), 0.0, [f, x = T(0.7)]() mutable {
+                    escape(x);
+                    do_not_optimize(mathlib::calculus::derivative(f, x));
+                    }, [n] { return *n; });
+            }
+            {
+                counter n = std::make_shared<std::size_t>(0);
+                auto f = [n](const mathlib::linalg::Vector<8, T>& x) {
+                    ++*n;
+                    T s{};
+                    for (std::size_t i = 0; i < 8; ++i) s += std::cos(x[i]) * static_cast<T>(i + 1);
+                    return s;
+                };
+                mathlib::linalg::Vector<8, T> x;
+                for (std::size_t i = 0; i < 8; ++i) x[i] = static_cast<T>(0.1) * static_cast<T>(i);
+                r.add(label<T>("gradient", 8), 0.0, [f, x]() mutable {
+                    escape(x);
+                    do_not_optimize(mathlib::calculus::gradient(f, x, static_cast<T>(1e-3)));
+                    }, [n] { return *n; });
+            }
+            {
+                counter n = std::make_shared<std::size_t>(0);
+                auto f = [n](T x) { ++*n; return std::exp(-x * x); };
+                r.add(label<T>("integrate_simpson", 1000), 0.0, [f, b = T(2)]() mutable {
+                    escape(b);
+                    do_not_optimize(mathlib::calculus::integrate_simpson(f, T(0), b, 1000));
+                    }, [n] { return *n; });
+                r.add(label<T>("integrate_simpson_neumaier", 1000), 0.0, [f, b = T(2)]() mutable {
+                    escape(b);
+                    do_not_optimize(mathlib::calculus::integrate_simpson(f, T(0), b, 1000, core::neumaier_sum{}));
+                    }, [n] { return *n; });
+                r.add(label<T>("integrate_adaptive_simpson"), 0.0, [f, b = T(2)]() mutable {
+                    escape(b);
+                    const T eps = sizeof(T) == 4 ? static_cast<T>(1e-5) : static_cast<T>(1e-10);
+                    do_not_optimize(mathlib::calculus::integrate_adaptive_simpson(f, T(0), b, eps));
+                    }, [n] { return *n; });
+            }
+            {
+                counter n = std::make_shared<std::size_t>(0);
+                auto f = [n](T x) { ++*n; return x * x * x - 2 * x - 5; };
+                const T eps = sizeof(T) == 4 ? static_cast<T>(1e-5) : static_cast<T>(1e-12);
+                r.add(label<T>("root_bisection"), 0.0, [f, eps, a = T(2)]() mutable {
+                    escape(a);
+                    do_not_optimize(mathlib::calculus::root_bisection(f, a, T(3), eps));
+                    }, [n] { return *n; });
+                r.add(label<T>("root_newton"), 0.0, [f, eps, x0 = T(2)]() mutable {
+                    escape(x0);
+                    do_not_optimize(mathlib::calculus::root_newton(f, x0, eps, 50, static_cast<T>(1e-3)));
+                    }, [n] { return *n; });
+            }
+        }
+
+    } // namespace
+
+    void register_calculus(Runner& r) {
+        register_type<float>(r);
+        register_type<double>(r);
+    }
+
+} // namespace mathlib::bench
@@ -0,0 +1,76 @@
+#include "benchmarks.hpp"
+
+#include <vector>
+
+#include "mathlib/kernels/kernels.hpp"
+
+namespace mathlib::bench {
+    namespace {
+
+        using mathlib::kernels::isa;
+
+        template <typename T>
+        std::vector<T> random_values(std::size_t n, std::uint64_t seed) {
+            std::vector<T> v(n);
+            for (auto& x : v) x = static_cast<T>(lcg_value(seed));
+            return v;
+        }
+
+        // "<what><T>/n@isa"; the body re-selects its path on every call
+        // (one atomic store) since benchmarks run after all are registered
+        template <typename T>
+        std::string name(const char* what, std::size_t n, isa i) {
+            return label<T>(what, n) + "@" + kernels::to_string(i);
+        }
+
+        template <typename T>
+        void register_path(Runner& r, isa i) {
+            constexpr std::size_t n = 4096;
+            r.add(name<T>("kernel_dot", n, i), 2.0 * n,
+                [i, x = random_values<T>(n, 1), y = random_values<T>(n, 2)]() mutable {
+                    kernels::set_isa(i);
+                    escape(x);
+                    escape(y);
+                    do_not_optimize(kernels::dot(x.data(), y.data(), n));
+                });
+
+            constexpr std::size_t m = 64;
+            r.add(name<T>("kernel_gemm", m, i), 2.0 * m * m * m,
+                [i, A = random_values<T>(m * m, 3), B = random_values<T>(m * m, 4), C = std::vector<T>(m * m)]() mutable {
+                    kernels::set_isa(i);
+                    escape(A);
+                    escape(B);
+                    kernels::gemm(A.data(), B.data(), C.data(), m, m, m);
+                    do_not_optimize(C.data()[0]);
+                });
+
+            // 256 diagonally dominant 8x8 systems per call
+            constexpr std::size_t count = 256, k = 8;
+            auto A = random_values<T>(count * k * k, 5);
+            for (std::size_t s = 0; s < count; ++s) {
+                for (std::size_t d = 0; d < k; ++d) A[s * k * k + d * k + d] += static_cast<T>(k);
+            }
+            r.add(name<T>("kernel_solve_batched", k, i), count * (2.0 / 3.0 * k * k * k + 2.0 * k * k),
+                [i, A, b = random_values<T>(count * k, 6), M = A, x = std::vector<T>(count * k)]() mutable {
+                    kernels::set_isa(i);
+                    M = A;
+                    x = b;
+                    do_not_optimize(kernels::solve_batched(M.data(), x.data(), count, k));
+                });
+        }
+
+        template <typename T>
+        void register_type(Runner& r) {
+            for (isa i : { isa::scalar, isa::sse2, isa::avx2, isa::avx512 }) {
+                if (i <= kernels::detected_isa()) register_path<T>(r, i);
+            }
+        }
+
+    } // namespace
+
+    void register_kernels(Runner& r) {
+        register_type<float>(r);
+        register_type<double>(r);
+    }
+
+} // namespace mathlib::bench
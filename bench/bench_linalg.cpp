@@ -0,0 +1,105 @@
+#include "benchmarks.hpp"
+
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/solve.hpp"
+#include "mathlib/linalg/vector.hpp"
+
+namespace mathlib::bench {
+    namespace {
+
+        using mathlib::linalg::Matrix;
+        using mathlib::linalg::Vector;
+
+        template <std::size_t R, std::size_t C, typename T>
+        Matrix<R, C, T> random_matrix(std::uint64_t seed, bool dominant = false) {
+            Matrix<R, C, T> A;
+            for (auto& x : A.a) x = static_cast<T>(lcg_value(seed));
+            if constexpr (R == C) {
+                if (dominant) {
+                    for (std::size_t i = 0; i < R; ++i) A(i, i) += static_cast<T>(R);
+                }
+            }
+            return A;
+        }
+
+        template <std::size_t N, typename T>
+        Vector<N, T> random_vector(std::uint64_t seed) {
+            Vector<N, T> v;
+            for (auto& x : v.v) x = static_cast<T>(lcg_value(seed));
+            return v;
+        }
+
+        template <std::size_t N, typename T>
+        void matmul(Runner& r) {
+            r.add(label<T>("matrix_mul", N), 2.0 * N * N * N,
+                [A = random_matrix<N, N, T>(1), B = random_matrix<N, N, T>(2)]() mutable {
+                    escape(A);
+                    escape(B);
+                    do_not_optimize(A * B);
+                });
+        }
+
+        template <std::size_t N, typename T>
+        void solve(Runner& r) {
+            // elimination 2/3 N^3 plus back substitution N^2
+            r.add(label<T>("solve", N), 2.0 / 3.0 * N * N * N + 2.0 * N * N,
+                [A = random_matrix<N, N, T>(3, true), b = random_vector<N, T>(4)]() mutable {
+                    escape(A);
+                    escape(b);
+                    do_not_optimize(mathlib::linalg::solve(A, b));
+                });
+        }
+
+        template <std::size_t N, typename T>
+        void transpose(Runner& r) {
+            r.add(label<T>("transpose", N), 0.0, [A = random_matrix<N, N, T>(5)]() mutable {
+                escape(A);
+                do_not_optimize(mathlib::linalg::transpose(A));
+                });
+        }
+
+        template <std::size_t N, typename T>
+        void vector_ops(Runner& r) {
+            r.add(label<T>("vector_dot", N), 2.0 * N,
+                [a = random_vector<N, T>(6), b = random_vector<N, T>(7)]() mutable {
+                    escape(a);
+                    escape(b);
+                    do_not_optimize(dot(a, b));
+                });
+            r.add(label<T>("vector_axpy", N), 2.0 * N,
+                [a = random_vector<N, T>(8), b = random_vector<N, T>(9)]() mutable {
+                    escape(a);
+                    escape(b);
+                    do_not_optimize(a + static_cast<T>(0.5) * b);
+                });
+            r.add(label<T>("vector_norm", N), 2.0 * N + 1, [a = random_vector<N, T>(10)]() mutable {
+                escape(a);
+                do_not_optimize(a.norm());
+                });
+        }
+
+        template <typename T>
+        void register_type(Runner& r) {
+            matmul<4, T>(r);
+            matmul<16, T>(r);
+            matmul<64, T>(r);
+            solve<2, T>(r);
+            solve<4, T>(r);
+            solve<8, T>(r);
+            solve<16, T>(r);
+            solve<32, T>(r);
+            solve<64, T>(r);
+            transpose<4, T>(r);
+            transpose<64, T>(r);
+            vector_ops<3, T>(r);
+            vector_ops<64, T>(r);
+        }
+
+    } // namespace
+
+    void register_linalg(Runner& r) {
+        register_type<float>(r);
+        register_type<double>(r);
+    }
+
+} // namespace mathlib::bench
@@ -0,0 +1,48 @@
+#include <memory>
+
+#include "benchmarks.hpp"
+
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/ode/solvers.hpp"
+
+namespace mathlib::bench {
+    namespace {
+
+        template <typename T>
+        void register_type(Runner& r) {
+            using V = mathlib::linalg::Vector<2, T>;
+            auto n = std::make_shared<std::size_t>(0);
+            // van der Pol, mu = 1 (non-stiff); observer overloads keep allocation out of the loop
+            auto f = [n](T, const V& y) {
+                ++*n;
+                return V{ y[1], (1 - y[0] * y[0]) * y[1] - y[0] };
+            };
+            auto ignore = [](const T&, const V&) {};
+            auto evals = [n] { return *n; };
+
+            r.add(label<T>("solve_euler", 1000), 0.0, [f, ignore, y0 = V{ 2, 0 }]() mutable {
+                escape(y0);
+                do_not_optimize(mathlib::ode::solve_euler(f, T(0), y0, T(10), T(0.01), ignore));
+                }, evals);
+            r.add(label<T>("solve_rk4", 1000), 0.0, [f, ignore, y0 = V{ 2, 0 }]() mutable {
+                escape(y0);
+                do_not_optimize(mathlib::ode::solve_rk4(f, T(0), y0, T(10), T(0.01), ignore));
+                }, evals);
+
+            mathlib::ode::Rk45Options<T> opt;
+            opt.rtol = sizeof(T) == 4 ? static_cast<T>(1e-4) : static_cast<T>(1e-8);
+            opt.atol = sizeof(T) == 4 ? static_cast<T>(1e-6) : static_cast<T>(1e-10);
+            r.add(label<T>("solve_rk45"), 0.0, [f, ignore, opt, y0 = V{ 2, 0 }]() mutable {
+                escape(y0);
+                do_not_optimize(mathlib::ode::solve_rk45(f, T(0), y0, T(10), opt, ignore));
+                }, evals);
+        }
+
+    } // namespace
+
+    void register_ode(Runner& r) {
+        register_type<float>(r);
+        register_type<double>(r);
+    }
+
+} // namespace mathlib::bench
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "harness.hpp"
+
+namespace mathlib::bench {
+
+    void register_linalg(Runner& r);
+    void register_calculus(Runner& r);
+    void register_ode(Runner& r);
+    void register_kernels(Runner& r); // only with MATHLIB_BUILD_KERNELS
+
+    template <typename T>
+    constexpr const char* type_name() { return sizeof(T) == 4 ? "float" : "double"; }
+
+    template <typename T>
+    std::string label(const char* what, std::size_t n = 0) {
+        std::string s = what;
+        s += '<';
+        s += type_name<T>();
+        s += '>';
+        if (n) {
+            s += '/';
+            s += std::to_string(n);
+        }
+        return s;
+    }
+
+    // Deterministic values in [-1, 1) (no <random> so runs are reproducible everywhere)
+    inline double lcg_value(std::uint64_t& state) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) / static_cast<double>(1ULL << 52) - 1.0;
+    }
+
+} // namespace mathlib::bench
@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal benchmark harness (no external dependencies).
+//
+// Each benchmark body performs one operation per call. The runner calibrates
+// a batch size so one sample lasts at least min_time, runs warmup samples,
+// then records `reps` samples and reports per-operation percentiles.
+namespace mathlib::bench {
+
+    // Keep a value (and everything that produced it) from being optimized out.
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // Make the compiler assume `value` may have been read and modified, so an
+    // input cannot be hoisted out of the timing loop or constant-folded.
+    template <typename T>
+    inline void escape(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        do_not_optimize(&value);
+#endif
+    }
+
+    // Force pending stores to be treated as observable.
+    inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    struct Options {
+        std::string filter;            // substring match on benchmark name
+        std::size_t reps = 15;
+        std::size_t warmup = 3;
+        double min_time_ms = 2.0;      // minimum duration of one sample
+        std::string json_path;         // write results here ("-" = stdout)
+        std::string baseline_path;     // compare against this file
+        double threshold = 0.10;       // relative slowdown flagged as regression
+    };
+
+    struct Result {
+        std::string name;
+        std::size_t batch = 0;         // operations per sample
+        double ns_median = 0, ns_p10 = 0, ns_p90 = 0, ns_min = 0;
+        double gflops = 0;             // at the median, 0 if flops unknown
+        double evals = 0;              // function evaluations per operation
+    };
+
+    struct Case {
+        std::string name;
+        double flops = 0;                           // floating-point operations per call
+        std::function<double(std::size_t)> sample;  // runs a batch, returns elapsed ns
+        std::function<std::size_t()> evals;         // running evaluation counter, may be empty
+    };
+
+    class Runner {
+        using clock = std::chrono::steady_clock;
+
+    public:
+        explicit Runner(Options opt) : opt_(std::move(opt)) {}
+
+        // Register a benchmark; `evals` reads a counter the body increments.
+        // The batch loop is instantiated per body so the call is inlined.
+        template <typename Body>
+        void add(std::string name, double flops, Body body, std::function<std::size_t()> evals = {}) {
+            auto sample = [body = std::move(body)](std::size_t batch) mutable {
+                const auto t0 = clock::now();
+                for (std::size_t i = 0; i < batch; ++i) body();
+                clobber_memory();
+                const auto t1 = clock::now();
+                return std::chrono::duration<double, std::nano>(t1 - t0).count();
+            };
+            cases_.push_back({ std::move(name), flops, std::move(sample), std::move(evals) });
+        }
+
+        std::vector<Result> run() const {
+            std::vector<Result> out;
+            for (const auto& c : cases_) {
+                if (!opt_.filter.empty() && c.name.find(opt_.filter) == std::string::npos) continue;
+                out.push_back(measure(c));
+                const auto& r = out.back();
+                std::cerr << std::left << std::setw(40) << r.name << std::right << std::fixed
+                    << std::setprecision(1) << std::setw(12) << r.ns_median << " ns/op";
+                if (r.gflops > 0) std::cerr << std::setprecision(2) << std::setw(9) << r.gflops << " GFLOP/s";
+                if (r.evals > 0) std::cerr << std::setprecision(1) << std::setw(9) << r.evals << " evals";
+                std::cerr << "\n";
+            }
+            return out;
+        }
+
+    private:
+
+        static double percentile(std::vector<double> v, double p) {
+            std::sort(v.begin(), v.end());
+            const double pos = p * static_cast<double>(v.size() - 1);
+            const std::size_t i = static_cast<std::size_t>(pos);
+            const double frac = pos - static_cast<double>(i);
+            return i + 1 < v.size() ? v[i] * (1 - frac) + v[i + 1] * frac : v[i];
+        }
+
+        Result measure(const Case& c) const {
+            // calibrate: grow the batch until one sample takes min_time
+            std::size_t batch = 1;
+            const double target = opt_.min_time_ms * 1e6;
+            for (;;) {
+                const double ns = c.sample(batch);
+                if (ns >= target || batch >= (std::size_t(1) << 30)) break;
+                const double scale = ns > 0 ? std::min(10.0, 1.4 * target / ns) : 10.0;
+                batch = std::max(batch + 1, static_cast<std::size_t>(static_cast<double>(batch) * scale));
+            }
+            for (std::size_t i = 0; i < opt_.warmup; ++i) c.sample(batch);
+
+            const std::size_t evals0 = c.evals ? c.evals() : 0;
+            std::vector<double> per_op;
+            per_op.reserve(opt_.reps);
+            for (std::size_t i = 0; i < std::max<std::size_t>(opt_.reps, 1); ++i) {
+                per_op.push_back(c.sample(batch) / static_cast<double>(batch));
+            }
+
+            Result r;
+            r.name = c.name;
+            r.batch = batch;
+            r.ns_median = percentile(per_op, 0.5);
+            r.ns_p10 = percentile(per_op, 0.1);
+            r.ns_p90 = percentile(per_op, 0.9);
+            r.ns_min = *std::min_element(per_op.begin(), per_op.end());
+            r.gflops = c.flops > 0 ? c.flops / r.ns_median : 0.0;
+            if (c.evals) {
+                r.evals = static_cast<double>(c.evals() - evals0) / static_cast<double>(batch * per_op.size());
+            }
+            return r;
+        }
+
+        Options opt_;
+        std::vector<Case> cases_;
+    };
+
+    // One result object per line so compare mode can read files back without
+    // a JSON library.
+    inline void write_json(std::ostream& os, const std::vector<Result>& results) {
+        os << "{\n  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            os << std::setprecision(6) << std::defaultfloat
+                << "    {\"name\": \"" << r.name << "\", \"ns_per_op\": " << r.ns_median
+                << ", \"p10\": " << r.ns_p10 << ", \"p90\": " << r.ns_p90 << ", \"min\": " << r.ns_min
+                << ", \"gflops\": " << r.gflops << ", \"evals_per_op\": " << r.evals
+                << ", \"batch\": " << r.batch << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        os << "  ]\n}\n";
+    }
+
+    // name -> ns_per_op from a file written by write_json
+    inline std::map<std::string, double> read_baseline(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("cannot open baseline " + path);
+        std::map<std::string, double> out;
+        std::string line;
+        const std::string name_key = "\"name\": \"", ns_key = "\"ns_per_op\": ";
+        while (std::getline(in, line)) {
+            const auto n = line.find(name_key);
+            const auto v = line.find(ns_key);
+            if (n == std::string::npos || v == std::string::npos) continue;
+            const auto start = n + name_key.size();
+            const auto end = line.find('"', start);
+            out[line.substr(start, end - start)] = std::stod(line.substr(v + ns_key.size()));
+        }
+        return out;
+    }
+
+    // Prints a comparison table; returns the number of regressions.
+    inline std::size_t compare(const std::vector<Result>& results, const std::map<std::string, double>& base,
+        double threshold) {
+        std::size_t regressions = 0;
+        for (const auto& r : results) {
+            const auto it = base.find(r.name);
+            if (it == base.end() || it->second <= 0) continue;
+            const double ratio = r.ns_median / it->second;
+            const bool slow = ratio > 1 + threshold;
+            regressions += slow;
+            std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed << std::setprecision(1)
+                << std::setw(12) << it->second << " -> " << std::setw(12) << r.ns_median << " ns  "
+                << std::showpos << std::setprecision(1) << (ratio - 1) * 100 << std::noshowpos << "%"
+                << (slow ? "  REGRESSION" : (ratio < 1 - threshold ? "  improved" : "")) << "\n";
+        }
+        return regressions;
+    }
+
+} // namespace mathlib::bench
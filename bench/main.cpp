@@ -0,0 +1,71 @@
+// mathlib_bench: micro-benchmarks for every subsystem.
+//
+//   mathlib_bench [--filter S] [--reps N] [--warmup N] [--min-time MS]
+//                 [--json FILE|-] [--compare BASELINE] [--threshold FRAC]
+//
+// Build with optimizations (e.g. -DCMAKE_BUILD_TYPE=Release). Save a baseline
+// with --json, later run with --compare to flag slowdowns above the threshold;
+// the exit status is 1 if any benchmark regressed.
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmarks.hpp"
+
+int main(int argc, char** argv) {
+    using namespace mathlib::bench;
+
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "missing value for " << a << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (a == "--filter") opt.filter = value();
+        else if (a == "--reps") opt.reps = std::stoul(value());
+        else if (a == "--warmup") opt.warmup = std::stoul(value());
+        else if (a == "--min-time") opt.min_time_ms = std::stod(value());
+        else if (a == "--json") opt.json_path = value();
+        else if (a == "--compare") opt.baseline_path = value();
+        else if (a == "--threshold") opt.threshold = std::stod(value());
+        else {
+            std::cerr << "usage: " << argv[0]
+                << " [--filter S] [--reps N] [--warmup N] [--min-time MS]"
+                   " [--json FILE|-] [--compare BASELINE] [--threshold FRAC]\n";
+            return a == "--help" || a == "-h" ? 0 : 2;
+        }
+    }
+
+    Runner runner(opt);
+    register_linalg(runner);
+    register_calculus(runner);
+    register_ode(runner);
+#if MATHLIB_BENCH_KERNELS
+    register_kernels(runner);
+#endif
+    const auto results = runner.run();
+
+    if (opt.json_path == "-") {
+        write_json(std::cout, results);
+    }
+    else if (!opt.json_path.empty()) {
+        std::ofstream out(opt.json_path);
+        write_json(out, results);
+        if (!out) {
+            std::cerr << "cannot write " << opt.json_path << "\n";
+            return 2;
+        }
+    }
+
+    if (!opt.baseline_path.empty()) {
+        const auto regressions = compare(results, read_baseline(opt.baseline_path), opt.threshold);
+        std::cout << regressions << " regression(s) above " << opt.threshold * 100 << "%\n";
+        return regressions ? 1 : 0;
+    }
+    return 0;
+}
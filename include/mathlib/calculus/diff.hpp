@@ -4,28 +4,41 @@
 #include <type_traits>
 
 #include "mathlib/core/error.hpp"
+#include "mathlib/core/instrument.hpp"
 
 namespace mathlib::calculus {
 
+	// All of these are constexpr: a bad h in a constant expression is a
+	// compile error.
+
 	// Central difference derivative (good default)
 	template <typename F, typename T>
-	T derivative_central(F f, T x, T h = static_cast<T>(1e-6)) {
+	constexpr T derivative_central(F f, T x, T h = static_cast<T>(1e-6)) {
 		static_assert(std::is_floating_point_v<T>, "derivative_central: T must be floating point");
-		if (h <= T{}) throw core::domain_error("derivative_central(): h must be > 0");
+		if (h <= T{}) MATHLIB_THROW(core::domain_error("derivative_central(): h must be > 0"));
 		return (f(x + h) - f(x - h)) / (static_cast<T>(2) * h);
 	}
 
+	// Same, recording evaluations in stats
+	template <typename F, typename T, typename Stats>
+		requires core::stats_policy<Stats>
+	constexpr T derivative_central(F f, T x, T h, Stats& stats) {
+		auto timer = stats.scoped_timer();
+		stats.add_evals(2);
+		return derivative_central<F, T>(f, x, h);
+	}
+
 	// Forward difference derivative (simpler, less accurate)
 	template <typename F, typename T>
-	T derivative_forward(F f, T x, T h = static_cast<T>(1e-6)) {
+	constexpr T derivative_forward(F f, T x, T h = static_cast<T>(1e-6)) {
 		static_assert(std::is_floating_point_v<T>, "derivative_forward: T must be floating point");
-		if (h <= T{}) throw core::domain_error("derivative_forward(): h must be > 0");
+		if (h <= T{}) MATHLIB_THROW(core::domain_error("derivative_forward(): h must be > 0"));
 		return (f(x + h) - f(x)) / h;
 	}
 
 	// Convenience default
 	template <typename F, typename T>
-	T derivative(F f, T x) {
+	constexpr T derivative(F f, T x) {
 		return derivative_central<F, T>(f, x);
 	}
 
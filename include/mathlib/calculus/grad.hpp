@@ -4,6 +4,7 @@
 
 #include "mathlib/linalg/vector.hpp"
 #include "mathlib/core/error.hpp"
+#include "mathlib/core/executor.hpp"
 
 namespace mathlib::calculus {
 
@@ -13,7 +14,7 @@ namespace mathlib::calculus {
         const mathlib::linalg::Vector<N, T>& x,
         T h = static_cast<T>(1e-6)) {
         static_assert(std::is_floating_point_v<T>, "gradient: T must be floating point");
-        if (h <= T{}) throw mathlib::core::domain_error("gradient(): h must be > 0");
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("gradient(): h must be > 0"));
 
         mathlib::linalg::Vector<N, T> g{};
 
@@ -27,5 +28,25 @@ namespace mathlib::calculus {
         return g;
     }
 
+    // Same, with the N components evaluated through an executor
+    template <typename Exec, typename F, std::size_t N, typename T>
+        requires mathlib::core::executor<std::remove_cvref_t<Exec>>
+    mathlib::linalg::Vector<N, T> gradient(Exec&& exec, F f,
+        const mathlib::linalg::Vector<N, T>& x,
+        T h = static_cast<T>(1e-6)) {
+        static_assert(std::is_floating_point_v<T>, "gradient: T must be floating point");
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("gradient(): h must be > 0"));
+
+        mathlib::linalg::Vector<N, T> g{};
+        exec.bulk(N, [&](std::size_t i) {
+            auto xp = x;
+            auto xm = x;
+            xp[i] += h;
+            xm[i] -= h;
+            g[i] = (f(xp) - f(xm)) / (static_cast<T>(2) * h);
+            });
+        return g;
+    }
+
 } // namespace mathlib::calculus
 
@@ -1,70 +1,371 @@
 #pragma once
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "mathlib/core/cmath.hpp"
 #include "mathlib/core/error.hpp"
+#include "mathlib/core/executor.hpp"
+#include "mathlib/core/expected.hpp"
+#include "mathlib/core/instrument.hpp"
+#include "mathlib/core/reduce.hpp"
 
 namespace mathlib::calculus {
 
-    // Simpson's rule with even n subintervals
-    template <typename F, typename T>
-    T integrate_simpson(F f, T a, T b, std::size_t n = 1000) {
+    // Simpson's rule with even n subintervals (stats records n + 1 evaluations).
+    // The weighted samples are summed by core::reduce_sum, pairwise by default
+    // or compensated with core::neumaier_sum{}.
+    template <typename F, typename T, typename Stats, typename Sum = core::pairwise_sum>
+        requires core::stats_policy<Stats> && core::summation_policy<Sum>
+    constexpr T integrate_simpson(F f, T a, T b, std::size_t n, Stats& stats, Sum sum = {}) {
+        auto timer = stats.scoped_timer();
         static_assert(std::is_floating_point_v<T>, "integrate_simpson: T must be floating point");
-        if (n < 2) throw core::domain_error("integrate_simpson(): n must be >= 2");
+        if (n < 2) MATHLIB_THROW(core::domain_error("integrate_simpson(): n must be >= 2"));
         if (n % 2 != 0) ++n; // make even
         if (a == b) return T{};
         if (b < a) std::swap(a, b);
 
         const T h = (b - a) / static_cast<T>(n);
-        T s = f(a) + f(b);
+        const T ends = f(a) + f(b);
+        const T inner = core::reduce_sum(n - 1, [&](std::size_t k) {
+            const std::size_t i = k + 1;
+            return (i % 2 == 0 ? static_cast<T>(2) : static_cast<T>(4)) * f(a + static_cast<T>(i) * h);
+            }, sum);
+        stats.add_evals(n + 1);
+        return (ends + inner) * (h / static_cast<T>(3));
+    }
 
-        for (std::size_t i = 1; i < n; ++i) {
-            T x = a + static_cast<T>(i) * h;
-            s += (i % 2 == 0 ? static_cast<T>(2) : static_cast<T>(4)) * f(x);
-        }
-        return s * (h / static_cast<T>(3));
+    template <typename F, typename T, typename Sum = core::pairwise_sum>
+        requires core::summation_policy<Sum>
+    constexpr T integrate_simpson(F f, T a, T b, std::size_t n = 1000, Sum sum = {}) {
+        core::null_stats stats;
+        return integrate_simpson(f, a, b, n, stats, sum);
     }
 
     // Internal: one Simpson step on [a,b]
     template <typename F, typename T>
-    T simpson_step(F f, T a, T b) {
+    constexpr T simpson_step(F f, T a, T b) {
         const T c = (a + b) / static_cast<T>(2);
         return (b - a) / static_cast<T>(6) * (f(a) + static_cast<T>(4) * f(c) + f(b));
     }
 
-    // Adaptive Simpson's rule
+    namespace detail {
+
+        // Adaptive Simpson recursion on [a,b] given the Simpson estimate `whole`.
+        // level counts down from the root (0) for depth statistics.
+        template <typename F, typename T, typename Stats>
+        constexpr T adaptive_simpson_rec(F f, T a, T b, T eps, T whole, std::size_t depth, std::size_t level, Stats& stats) {
+            const T c = (a + b) / static_cast<T>(2);
+            const T left = simpson_step<F, T>(f, a, c);
+            const T right = simpson_step<F, T>(f, c, b);
+            const T delta = left + right - whole;
+            stats.add_evals(6);
+            stats.note_depth(level);
+
+            // if good enough or depth exhausted
+            const bool ok = core::cmath::abs(delta) <= static_cast<T>(15) * eps;
+            if (depth == 0 || ok) {
+                if constexpr (Stats::enabled) {
+                    // leaves sum their error estimates; a leaf cut off by depth is a failure
+                    stats.add_accepted();
+                    if (!ok) {
+                        stats.add_rejected(1);
+                        stats.set_converged(false);
+                    }
+                    stats.add_error(static_cast<double>(core::cmath::abs(delta)) / 15);
+                    if constexpr (Stats::tracing) {
+                        stats.event({ "integrate_adaptive_simpson", ok ? "leaf" : "depth_limit", level,
+                            static_cast<double>(a), static_cast<double>(b), static_cast<double>(core::cmath::abs(delta)) / 15 });
+                    }
+                }
+                // Richardson extrapolation correction
+                return left + right + delta / static_cast<T>(15);
+            }
+            return adaptive_simpson_rec(f, a, c, eps / static_cast<T>(2), left, depth - 1, level + 1, stats) +
+                adaptive_simpson_rec(f, c, b, eps / static_cast<T>(2), right, depth - 1, level + 1, stats);
+        }
+
+        template <typename F, typename T>
+        constexpr T adaptive_simpson_rec(F f, T a, T b, T eps, T whole, std::size_t depth) {
+            core::null_stats stats;
+            return adaptive_simpson_rec(f, a, b, eps, whole, depth, 0, stats);
+        }
+
+    } // namespace detail
+
+    // Adaptive Simpson's rule. Stats records evaluations, the deepest level
+    // reached, accepted leaves, leaves cut off by max_recursion (rejected; then
+    // converged is false) and the summed error estimate of the leaves.
+    template <typename F, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    constexpr T integrate_adaptive_simpson(F f, T a, T b, T eps, std::size_t max_recursion, Stats& stats) {
+        auto timer = stats.scoped_timer();
+        static_assert(std::is_floating_point_v<T>, "integrate_adaptive_simpson: T must be floating point");
+        if (eps <= T{}) MATHLIB_THROW(core::domain_error("integrate_adaptive_simpson(): eps must be > 0"));
+        if (a == b) return T{};
+        if (b < a) std::swap(a, b);
+
+        const T whole = simpson_step<F, T>(f, a, b);
+        stats.add_evals(3);
+        stats.set_error(0.0);
+        stats.set_converged(true);
+        return detail::adaptive_simpson_rec(f, a, b, eps, whole, max_recursion, 0, stats);
+    }
+
     template <typename F, typename T>
-    T integrate_adaptive_simpson(F f, T a, T b,
+    constexpr T integrate_adaptive_simpson(F f, T a, T b,
         T eps = static_cast<T>(1e-10),
         std::size_t max_recursion = 20) {
-        static_assert(std::is_floating_point_v<T>, "integrate_adaptive_simpson: T must be floating point");
-        if (eps <= T{}) throw core::domain_error("integrate_adaptive_simpson(): eps must be > 0");
+        core::null_stats stats;
+        return integrate_adaptive_simpson(f, a, b, eps, max_recursion, stats);
+    }
+
+    template <typename T>
+    struct QuadratureResult {
+        T value{};
+        T error{}; // estimated absolute error
+    };
+
+    namespace detail {
+
+        // 15-point Kronrod nodes on [0, 1] (odd indices are the 7-point Gauss
+        // nodes) and weights, from QUADPACK qk15
+        template <typename T>
+        inline constexpr T gk15_nodes[8] = {
+            static_cast<T>(0.991455371120812639206854697526329L), static_cast<T>(0.949107912342758524526189684047851L),
+            static_cast<T>(0.864864423359769072789712788640926L), static_cast<T>(0.741531185599394439863864773280788L),
+            static_cast<T>(0.586087235467691130294144845693013L), static_cast<T>(0.405845151377397166906606412076961L),
+            static_cast<T>(0.207784955007898467600689403773245L), T{} };
+
+        template <typename T>
+        inline constexpr T gk15_kronrod_weights[8] = {
+            static_cast<T>(0.022935322010529224963732008058970L), static_cast<T>(0.063092092629978553290700663189204L),
+            static_cast<T>(0.104790010322250183839876322541518L), static_cast<T>(0.140653259715525918745189590510238L),
+            static_cast<T>(0.169004726639267902826583426598550L), static_cast<T>(0.190350578064785409913256402421014L),
+            static_cast<T>(0.204432940075298892414161999234649L), static_cast<T>(0.209482141084727828012999174891714L) };
+
+        template <typename T>
+        inline constexpr T gk15_gauss_weights[4] = {
+            static_cast<T>(0.129484966168869693270611432679082L), static_cast<T>(0.279705391489276667901467771423780L),
+            static_cast<T>(0.381830050505118944950369775488975L), static_cast<T>(0.417959183673469387755102040816327L) };
+
+    } // namespace detail
+
+    // 7-point Gauss / 15-point Kronrod rule on [a,b] (15 evaluations). The
+    // error estimate is QUADPACK's: |K15 - G7| scaled by the rule's own
+    // smoothness measure and floored at the rounding level.
+    template <typename F, typename T>
+    constexpr QuadratureResult<T> gauss_kronrod15(F f, T a, T b) {
+        static_assert(std::is_floating_point_v<T>, "gauss_kronrod15: T must be floating point");
+        using core::cmath::abs;
+        const T centre = (a + b) / static_cast<T>(2);
+        const T half = (b - a) / static_cast<T>(2);
+
+        const T fc = f(centre);
+        T resg = fc * detail::gk15_gauss_weights<T>[3];
+        T resk = fc * detail::gk15_kronrod_weights<T>[7];
+        T resabs = abs(resk);
+        T fv1[7]{}, fv2[7]{};
+        for (std::size_t j = 0; j < 7; ++j) {
+            const T dx = half * detail::gk15_nodes<T>[j];
+            fv1[j] = f(centre - dx);
+            fv2[j] = f(centre + dx);
+            const T sum = fv1[j] + fv2[j];
+            if (j % 2 == 1) resg += detail::gk15_gauss_weights<T>[j / 2] * sum;
+            resk += detail::gk15_kronrod_weights<T>[j] * sum;
+            resabs += detail::gk15_kronrod_weights<T>[j] * (abs(fv1[j]) + abs(fv2[j]));
+        }
+
+        const T mean = resk / static_cast<T>(2);
+        T resasc = detail::gk15_kronrod_weights<T>[7] * abs(fc - mean);
+        for (std::size_t j = 0; j < 7; ++j) {
+            resasc += detail::gk15_kronrod_weights<T>[j] * (abs(fv1[j] - mean) + abs(fv2[j] - mean));
+        }
+
+        const T ah = abs(half);
+        resabs *= ah;
+        resasc *= ah;
+        T err = abs((resk - resg) * half);
+        if (resasc != T{} && err != T{}) {
+            const T r = static_cast<T>(200) * err / resasc;
+            err = resasc * std::min(static_cast<T>(1), r * core::cmath::sqrt(r));
+        }
+        constexpr T eps = std::numeric_limits<T>::epsilon();
+        if (resabs > std::numeric_limits<T>::min() / (static_cast<T>(50) * eps)) {
+            err = std::max(static_cast<T>(50) * eps * resabs, err);
+        }
+        return { resk * half, err };
+    }
+
+    // Composite G7/K15 over n equal panels; error is the sum of the panel estimates.
+    template <typename F, typename T>
+    constexpr QuadratureResult<T> integrate_gauss_kronrod(F f, T a, T b, std::size_t n = 1) {
+        if (n < 1) MATHLIB_THROW(core::domain_error("integrate_gauss_kronrod(): n must be >= 1"));
+        const T h = (b - a) / static_cast<T>(n);
+        QuadratureResult<T> total;
+        for (std::size_t i = 0; i < n; ++i) {
+            const T lo = a + static_cast<T>(i) * h;
+            const T hi = (i + 1 == n) ? b : lo + h;
+            const QuadratureResult<T> part = gauss_kronrod15<F, T>(f, lo, hi);
+            total.value += part.value;
+            total.error += part.error;
+        }
+        return total;
+    }
+
+    // Non-throwing variants: argument errors come back as invalid_argument.
+    // An adaptive run cut off by max_recursion still returns its estimate;
+    // pass stats to see the rejected leaves and converged flag.
+    template <typename F, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    core::expected<T, core::error_code> try_integrate_simpson(F f, T a, T b, std::size_t n, Stats& stats) noexcept {
+        if (n < 2) return core::fail(core::error_code::invalid_argument);
+        return integrate_simpson(std::move(f), a, b, n, stats);
+    }
+
+    template <typename F, typename T>
+    core::expected<T, core::error_code> try_integrate_simpson(F f, T a, T b, std::size_t n = 1000) noexcept {
+        core::null_stats stats;
+        return try_integrate_simpson(std::move(f), a, b, n, stats);
+    }
+
+    template <typename F, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    core::expected<T, core::error_code> try_integrate_adaptive_simpson(F f, T a, T b, T eps,
+        std::size_t max_recursion, Stats& stats) noexcept {
+        if (!(eps > T{})) return core::fail(core::error_code::invalid_argument);
+        return integrate_adaptive_simpson(std::move(f), a, b, eps, max_recursion, stats);
+    }
+
+    template <typename F, typename T>
+    core::expected<T, core::error_code> try_integrate_adaptive_simpson(F f, T a, T b,
+        T eps = static_cast<T>(1e-10),
+        std::size_t max_recursion = 20) noexcept {
+        core::null_stats stats;
+        return try_integrate_adaptive_simpson(std::move(f), a, b, eps, max_recursion, stats);
+    }
+
+    // -----------------------
+    // Executor overloads
+    // -----------------------
+    // Samples are split into fixed chunks of simpson_grain points whose partial
+    // sums are combined in a fixed tree order, so the result is bit-identical
+    // for any executor and thread count.
+    inline constexpr std::size_t simpson_grain = 4096;
+
+    template <typename Exec, typename F, typename T>
+        requires core::executor<std::remove_cvref_t<Exec>>
+    T integrate_simpson(Exec&& exec, F f, T a, T b, std::size_t n = 1000) {
+        static_assert(std::is_floating_point_v<T>, "integrate_simpson: T must be floating point");
+        if (n < 2) MATHLIB_THROW(core::domain_error("integrate_simpson(): n must be >= 2"));
+        if (n % 2 != 0) ++n; // make even
         if (a == b) return T{};
         if (b < a) std::swap(a, b);
 
-        const T whole = simpson_step<F, T>(f, a, b);
+        const T h = (b - a) / static_cast<T>(n);
+        const std::size_t inner = n - 1; // samples 1..n-1
+        const std::size_t chunks = (inner + simpson_grain - 1) / simpson_grain;
+
+        T s = core::parallel_reduce<T>(exec, chunks,
+            [&](std::size_t c) {
+                const std::size_t lo = 1 + c * simpson_grain;
+                const std::size_t hi = std::min(lo + simpson_grain, n);
+                return core::reduce_sum(hi - lo, [&](std::size_t k) {
+                    const std::size_t i = lo + k;
+                    return (i % 2 == 0 ? static_cast<T>(2) : static_cast<T>(4)) * f(a + static_cast<T>(i) * h);
+                    });
+            },
+            [](T l, T r) { return l + r; });
+        s += f(a) + f(b);
+        return s * (h / static_cast<T>(3));
+    }
 
-        // recursive lambda (C++17-friendly)
-        struct Helper {
-            static T rec(F f, T a, T b, T eps, T whole, std::size_t depth) {
-                const T c = (a + b) / static_cast<T>(2);
-                const T left = simpson_step<F, T>(f, a, c);
-                const T right = simpson_step<F, T>(f, c, b);
-                const T delta = left + right - whole;
-
-                // if good enough or depth exhausted
-                if (depth == 0 || std::abs(delta) <= static_cast<T>(15) * eps) {
-                    // Richardson extrapolation correction
-                    return left + right + delta / static_cast<T>(15);
+    namespace detail {
+
+        // Adaptive Simpson tree shared by the scalar and vector executor
+        // overloads. The tree is expanded breadth-first until there are
+        // enough open subintervals to keep the executor busy; those subtrees
+        // then run concurrently through `rec`. Every node performs exactly
+        // the serial algorithm's work and results are combined along the same
+        // tree, so the value is bit-identical to the serial recursion.
+        //   step(a, b)                     Simpson estimate on [a, b]
+        //   norm(delta)                    error measure compared with 15 * eps
+        //   rec(a, b, eps, whole, depth)   serial recursion for a subtree
+        template <typename V, typename Exec, typename T, typename Step, typename Norm, typename Rec>
+        V parallel_adaptive_simpson(Exec& exec, T a, T b, T eps, std::size_t max_recursion,
+            Step step, Norm norm, Rec rec) {
+            struct Node {
+                T a, b, eps;
+                V whole;
+                std::size_t depth;
+                V value{};
+                std::size_t left = 0, right = 0; // children (0 = leaf)
+            };
+
+            std::vector<Node> nodes;
+            nodes.push_back({ a, b, eps, step(a, b), max_recursion });
+
+            const std::size_t target = 4 * exec.concurrency();
+            std::vector<std::size_t> frontier{ 0 };
+            while (!frontier.empty() && frontier.size() < target) {
+                std::vector<std::size_t> next;
+                for (std::size_t id : frontier) {
+                    const Node nd = nodes[id];
+                    const T c = (nd.a + nd.b) / static_cast<T>(2);
+                    const V left = step(nd.a, c);
+                    const V right = step(c, nd.b);
+                    const V delta = (left + right) - nd.whole;
+                    if (nd.depth == 0 || norm(delta) <= static_cast<T>(15) * nd.eps) {
+                        nodes[id].value = left + right + delta / static_cast<T>(15);
+                        continue;
+                    }
+                    nodes[id].left = nodes.size();
+                    nodes.push_back({ nd.a, c, nd.eps / static_cast<T>(2), left, nd.depth - 1 });
+                    nodes[id].right = nodes.size();
+                    nodes.push_back({ c, nd.b, nd.eps / static_cast<T>(2), right, nd.depth - 1 });
+                    next.push_back(nodes[id].left);
+                    next.push_back(nodes[id].right);
                 }
-                return rec(f, a, c, eps / static_cast<T>(2), left, depth - 1) +
-                    rec(f, c, b, eps / static_cast<T>(2), right, depth - 1);
+                frontier.swap(next);
             }
-        };
 
-        return Helper::rec(f, a, b, eps, whole, max_recursion);
+            exec.bulk(frontier.size(), [&](std::size_t k) {
+                Node& nd = nodes[frontier[k]];
+                nd.value = rec(nd.a, nd.b, nd.eps, nd.whole, nd.depth);
+                });
+
+            // Children always have larger indices, so a reverse sweep sums bottom-up
+            for (std::size_t id = nodes.size(); id-- > 0;) {
+                if (nodes[id].left != 0) nodes[id].value = nodes[nodes[id].left].value + nodes[nodes[id].right].value;
+            }
+            return nodes[0].value;
+        }
+
+    } // namespace detail
+
+    // Parallel adaptive Simpson (see detail::parallel_adaptive_simpson);
+    // bit-identical to integrate_adaptive_simpson(f, a, b, ...).
+    template <typename Exec, typename F, typename T>
+        requires core::executor<std::remove_cvref_t<Exec>>
+    T integrate_adaptive_simpson(Exec&& exec, F f, T a, T b,
+        T eps = static_cast<T>(1e-10),
+        std::size_t max_recursion = 20) {
+        static_assert(std::is_floating_point_v<T>, "integrate_adaptive_simpson: T must be floating point");
+        if (eps <= T{}) MATHLIB_THROW(core::domain_error("integrate_adaptive_simpson(): eps must be > 0"));
+        if (a == b) return T{};
+        if (b < a) std::swap(a, b);
+
+        return detail::parallel_adaptive_simpson<T>(exec, a, b, eps, max_recursion,
+            [&](T l, T r) { return simpson_step<F, T>(f, l, r); },
+            [](T delta) { return core::cmath::abs(delta); },
+            [&](T l, T r, T e, T whole, std::size_t depth) {
+                return detail::adaptive_simpson_rec<F, T>(f, l, r, e, whole, depth);
+            });
     }
 
 } // namespace mathlib::calculus
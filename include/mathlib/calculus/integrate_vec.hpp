@@ -1,10 +1,16 @@
 #pragma once
+#include <algorithm>
 #include <cstddef>
 #include <cmath>
+#include <type_traits>
 #include <utility>
 
 #include "mathlib/linalg/vector.hpp"
+#include "mathlib/core/cmath.hpp"
 #include "mathlib/core/error.hpp"
+#include "mathlib/core/executor.hpp"
+#include "mathlib/core/reduce.hpp"
+#include "mathlib/calculus/integrate.hpp"
 
 namespace mathlib::calculus {
 
@@ -13,63 +19,116 @@ namespace mathlib::calculus {
 
     // Simpson step for vector output
     template <typename F, std::size_t N, typename T>
-    Vec<N, T> simpson_step_vec(F f, T a, T b) {
+    constexpr Vec<N, T> simpson_step_vec(F f, T a, T b) {
         const T c = (a + b) / static_cast<T>(2);
         return (b - a) / static_cast<T>(6) * (f(a) + static_cast<T>(4) * f(c) + f(b));
     }
 
     // Fixed-interval Simpson for vector output
     template <typename F, std::size_t N, typename T>
-    Vec<N, T> integrate_simpson_vec(F f, T a, T b, std::size_t n = 1000) {
-        if (n < 2) throw core::domain_error("integrate_simpson_vec(): n must be >= 2");
+    constexpr Vec<N, T> integrate_simpson_vec(F f, T a, T b, std::size_t n = 1000) {
+        if (n < 2) MATHLIB_THROW(core::domain_error("integrate_simpson_vec(): n must be >= 2"));
         if (n % 2 != 0) ++n;
         if (a == b) return Vec<N, T>{};
         if (b < a) std::swap(a, b);
 
         const T h = (b - a) / static_cast<T>(n);
-        Vec<N, T> s = f(a) + f(b);
+        const Vec<N, T> ends = f(a) + f(b);
+        // pairwise over whole vectors (neumaier_sum is scalar-only)
+        const Vec<N, T> inner = core::reduce_sum(n - 1, [&](std::size_t k) -> Vec<N, T> {
+            const std::size_t i = k + 1;
+            return (i % 2 == 0 ? static_cast<T>(2) : static_cast<T>(4)) * f(a + static_cast<T>(i) * h);
+            });
+        return (ends + inner) * (h / static_cast<T>(3));
+    }
+
+    namespace detail {
 
-        for (std::size_t i = 1; i < n; ++i) {
-            T x = a + static_cast<T>(i) * h;
-            s = s + (i % 2 == 0 ? static_cast<T>(2) : static_cast<T>(4)) * f(x);
+        template <std::size_t N, typename T>
+        constexpr T max_abs_component(const Vec<N, T>& v) {
+            T max_abs = T{};
+            for (std::size_t i = 0; i < N; ++i) max_abs = std::max(max_abs, core::cmath::abs(v[i]));
+            return max_abs;
         }
-        return s * (h / static_cast<T>(3));
-    }
+
+        template <typename F, std::size_t N, typename T>
+        constexpr Vec<N, T> adaptive_simpson_vec_rec(F f, T a, T b, T eps, Vec<N, T> whole, std::size_t depth) {
+            const T c = (a + b) / static_cast<T>(2);
+            const Vec<N, T> left = simpson_step_vec<F, N, T>(f, a, c);
+            const Vec<N, T> right = simpson_step_vec<F, N, T>(f, c, b);
+
+            const Vec<N, T> delta = (left + right) - whole;
+
+            // component-wise stopping: use max abs component
+            if (depth == 0 || max_abs_component(delta) <= static_cast<T>(15) * eps) {
+                return left + right + delta / static_cast<T>(15);
+            }
+
+            return adaptive_simpson_vec_rec<F, N, T>(f, a, c, eps / static_cast<T>(2), left, depth - 1) +
+                adaptive_simpson_vec_rec<F, N, T>(f, c, b, eps / static_cast<T>(2), right, depth - 1);
+        }
+
+    } // namespace detail
 
     // Adaptive Simpson for vector output
     template <typename F, std::size_t N, typename T>
-    Vec<N, T> integrate_adaptive_simpson_vec(F f, T a, T b,
+    constexpr Vec<N, T> integrate_adaptive_simpson_vec(F f, T a, T b,
         T eps = static_cast<T>(1e-10),
         std::size_t max_recursion = 20) {
-        if (eps <= T{}) throw core::domain_error("integrate_adaptive_simpson_vec(): eps must be > 0");
+        if (eps <= T{}) MATHLIB_THROW(core::domain_error("integrate_adaptive_simpson_vec(): eps must be > 0"));
         if (a == b) return Vec<N, T>{};
         if (b < a) std::swap(a, b);
 
         const Vec<N, T> whole = simpson_step_vec<F, N, T>(f, a, b);
 
-        struct Helper {
-            static Vec<N, T> rec(F f, T a, T b, T eps, Vec<N, T> whole, std::size_t depth) {
-                const T c = (a + b) / static_cast<T>(2);
-                const Vec<N, T> left = simpson_step_vec<F, N, T>(f, a, c);
-                const Vec<N, T> right = simpson_step_vec<F, N, T>(f, c, b);
-
-                const Vec<N, T> delta = (left + right) - whole;
+        return detail::adaptive_simpson_vec_rec<F, N, T>(f, a, b, eps, whole, max_recursion);
+    }
 
-                // component-wise stopping: use max abs component
-                T max_abs = T{};
-                for (std::size_t i = 0; i < N; ++i) max_abs = std::max(max_abs, std::abs(delta[i]));
+    // -----------------------
+    // Executor overloads (see integrate.hpp; same fixed partitioning)
+    // -----------------------
+    template <typename Exec, typename F, std::size_t N, typename T>
+        requires core::executor<std::remove_cvref_t<Exec>>
+    Vec<N, T> integrate_simpson_vec(Exec&& exec, F f, T a, T b, std::size_t n = 1000) {
+        if (n < 2) MATHLIB_THROW(core::domain_error("integrate_simpson_vec(): n must be >= 2"));
+        if (n % 2 != 0) ++n;
+        if (a == b) return Vec<N, T>{};
+        if (b < a) std::swap(a, b);
 
-                if (depth == 0 || max_abs <= static_cast<T>(15) * eps) {
-                    return left + right + delta / static_cast<T>(15);
-                }
+        const T h = (b - a) / static_cast<T>(n);
+        const std::size_t inner = n - 1;
+        const std::size_t chunks = (inner + simpson_grain - 1) / simpson_grain;
+
+        Vec<N, T> s = core::parallel_reduce<Vec<N, T>>(exec, chunks,
+            [&](std::size_t c) {
+                const std::size_t lo = 1 + c * simpson_grain;
+                const std::size_t hi = std::min(lo + simpson_grain, n);
+                return core::reduce_sum(hi - lo, [&](std::size_t k) -> Vec<N, T> {
+                    const std::size_t i = lo + k;
+                    return (i % 2 == 0 ? static_cast<T>(2) : static_cast<T>(4)) * f(a + static_cast<T>(i) * h);
+                    });
+            },
+            [](const Vec<N, T>& l, const Vec<N, T>& r) { return l + r; });
+        s = s + (f(a) + f(b));
+        return s * (h / static_cast<T>(3));
+    }
 
-                return rec(f, a, c, eps / static_cast<T>(2), left, depth - 1) +
-                    rec(f, c, b, eps / static_cast<T>(2), right, depth - 1);
-            }
-        };
+    // Parallel adaptive Simpson for vector output; bit-identical to the serial version.
+    template <typename Exec, typename F, std::size_t N, typename T>
+        requires core::executor<std::remove_cvref_t<Exec>>
+    Vec<N, T> integrate_adaptive_simpson_vec(Exec&& exec, F f, T a, T b,
+        T eps = static_cast<T>(1e-10),
+        std::size_t max_recursion = 20) {
+        if (eps <= T{}) MATHLIB_THROW(core::domain_error("integrate_adaptive_simpson_vec(): eps must be > 0"));
+        if (a == b) return Vec<N, T>{};
+        if (b < a) std::swap(a, b);
 
-        return Helper::rec(f, a, b, eps, whole, max_recursion);
+        return detail::parallel_adaptive_simpson<Vec<N, T>>(exec, a, b, eps, max_recursion,
+            [&](T l, T r) { return simpson_step_vec<F, N, T>(f, l, r); },
+            [](const Vec<N, T>& delta) { return detail::max_abs_component(delta); },
+            [&](T l, T r, T e, const Vec<N, T>& whole, std::size_t depth) {
+                return detail::adaptive_simpson_vec_rec<F, N, T>(f, l, r, e, whole, depth);
+            });
     }
 
 } // namespace mathlib::calculus
-#pragma once
@@ -0,0 +1,93 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/core/error.hpp"
+
+namespace mathlib::calculus {
+
+    // Forward-difference Jacobian of F: R^N -> R^N at x, reusing fx = F(x).
+    // One extra F evaluation per column (N total). h <= 0 picks sqrt(eps).
+    template <typename F, std::size_t N, typename T>
+    mathlib::linalg::Matrix<N, N, T> jacobian_forward(F f,
+        const mathlib::linalg::Vector<N, T>& x,
+        const mathlib::linalg::Vector<N, T>& fx,
+        T h = T{}) {
+        static_assert(std::is_floating_point_v<T>, "jacobian_forward: T must be floating point");
+        if (h <= T{}) h = std::sqrt(std::numeric_limits<T>::epsilon());
+
+        mathlib::linalg::Matrix<N, N, T> J{};
+        auto xp = x;
+        for (std::size_t j = 0; j < N; ++j) {
+            const T hj = h * std::max(std::abs(x[j]), static_cast<T>(1));
+            xp[j] = x[j] + hj;
+            const T dx = xp[j] - x[j]; // exactly representable step
+            const auto fp = f(xp);
+            for (std::size_t i = 0; i < N; ++i) J(i, j) = (fp[i] - fx[i]) / dx;
+            xp[j] = x[j];
+        }
+        return J;
+    }
+
+    // Forward-difference Jacobian of a banded F (entries only for
+    // i - j <= lower and j - i <= upper). Columns that are more than
+    // lower + upper apart never touch the same row, so they are perturbed
+    // together: lower + upper + 1 evaluations instead of N.
+    template <typename F, std::size_t N, typename T>
+    mathlib::linalg::Matrix<N, N, T> jacobian_forward_banded(F f,
+        const mathlib::linalg::Vector<N, T>& x,
+        const mathlib::linalg::Vector<N, T>& fx,
+        std::size_t lower, std::size_t upper,
+        T h = T{}) {
+        static_assert(std::is_floating_point_v<T>, "jacobian_forward_banded: T must be floating point");
+        if (h <= T{}) h = std::sqrt(std::numeric_limits<T>::epsilon());
+        lower = std::min(lower, N - 1);
+        upper = std::min(upper, N - 1);
+        const std::size_t width = lower + upper + 1;
+        if (width >= N) return jacobian_forward(f, x, fx, h);
+
+        mathlib::linalg::Matrix<N, N, T> J{};
+        mathlib::linalg::Vector<N, T> dx{};
+        for (std::size_t g = 0; g < width; ++g) {
+            auto xp = x;
+            for (std::size_t j = g; j < N; j += width) {
+                xp[j] = x[j] + h * std::max(std::abs(x[j]), static_cast<T>(1));
+                dx[j] = xp[j] - x[j];
+            }
+            const auto fp = f(xp);
+            for (std::size_t j = g; j < N; j += width) {
+                const std::size_t i0 = (j > upper) ? j - upper : 0;
+                const std::size_t i1 = std::min(N - 1, j + lower);
+                for (std::size_t i = i0; i <= i1; ++i) J(i, j) = (fp[i] - fx[i]) / dx[j];
+            }
+        }
+        return J;
+    }
+
+    // Central-difference Jacobian (2N evaluations, O(h^2) accurate)
+    template <typename F, std::size_t N, typename T>
+    mathlib::linalg::Matrix<N, N, T> jacobian_central(F f,
+        const mathlib::linalg::Vector<N, T>& x,
+        T h = static_cast<T>(1e-6)) {
+        static_assert(std::is_floating_point_v<T>, "jacobian_central: T must be floating point");
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("jacobian_central(): h must be > 0"));
+
+        mathlib::linalg::Matrix<N, N, T> J{};
+        for (std::size_t j = 0; j < N; ++j) {
+            auto xp = x;
+            auto xm = x;
+            xp[j] += h;
+            xm[j] -= h;
+            const auto fp = f(xp);
+            const auto fm = f(xm);
+            for (std::size_t i = 0; i < N; ++i) J(i, j) = (fp[i] - fm[i]) / (static_cast<T>(2) * h);
+        }
+        return J;
+    }
+
+} // namespace mathlib::calculus
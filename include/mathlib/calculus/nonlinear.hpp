@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "mathlib/linalg/lu.hpp"
+#include "mathlib/linalg/solve.hpp"
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/calculus/jacobian.hpp"
+#include "mathlib/core/error.hpp"
+
+namespace mathlib::calculus {
+
+    template <typename T>
+    struct NonlinearOptions {
+        T tol_f = static_cast<T>(1e-10);        // stop when max|F(x)| <= tol_f
+        T tol_x = static_cast<T>(1e-14);        // ... or when max|dx| <= tol_x * (1 + max|x|)
+        std::size_t max_iter = 100;
+        bool broyden = true;                    // rank-1 updates between Jacobian refreshes
+        T refresh_ratio = static_cast<T>(0.5);  // re-evaluate J when ||F|| shrinks by less than this
+        T fd_step = T{};                        // forward-difference step (0 = sqrt(eps))
+        T pivot_eps = static_cast<T>(1e-12);
+    };
+
+    template <std::size_t N, typename T>
+    struct NonlinearResult {
+        mathlib::linalg::Vector<N, T> x{};
+        T f_norm{};                     // max|F(x)| at the returned x
+        std::size_t iterations = 0;
+        std::size_t f_evals = 0;        // includes evaluations spent on finite differences
+        std::size_t jacobian_evals = 0;
+        bool converged = false;
+        bool stagnated = false;         // steps became negligible (or no descent) with a fresh
+                                        // Jacobian while max|F| > tol_f: likely no root nearby
+    };
+
+    namespace detail {
+
+        template <std::size_t N, typename T>
+        T max_abs(const mathlib::linalg::Vector<N, T>& v) {
+            T m{};
+            for (std::size_t i = 0; i < N; ++i) m = std::max(m, std::abs(v[i]));
+            return m;
+        }
+
+        // Newton/Broyden driver. `jac(x, fx)` returns the Jacobian at x.
+        // A fresh Jacobian is factored once and inverted (O(N^3)); the
+        // inverse is reused while ||F|| keeps dropping fast and refined by
+        // Sherman-Morrison (Broyden) updates, so each step in between costs
+        // O(N^2) and no extra F evaluations. A slow iteration, a failed line
+        // search or a negligible step triggers a fresh Jacobian.
+        template <typename F, typename J, std::size_t N, typename T>
+        NonlinearResult<N, T> solve_nonlinear_impl(F& f, J& jac,
+            const mathlib::linalg::Vector<N, T>& x0, const NonlinearOptions<T>& opt) {
+            using Vec = mathlib::linalg::Vector<N, T>;
+            using Mat = mathlib::linalg::Matrix<N, N, T>;
+
+            NonlinearResult<N, T> res;
+            Vec x = x0;
+            Vec fx = f(x);
+            ++res.f_evals;
+            T phi = dot(fx, fx);
+
+            Mat H{}; // inverse of the current Jacobian approximation
+            bool need_jac = true;
+            bool fresh = false;
+
+            for (; res.iterations < opt.max_iter; ++res.iterations) {
+                if (max_abs(fx) <= opt.tol_f) {
+                    res.converged = true;
+                    break;
+                }
+
+                if (need_jac) {
+                    mathlib::linalg::LU<N, T> lu;
+                    lu.lu = jac(x, fx);
+                    ++res.jacobian_evals;
+                    if (!mathlib::linalg::detail::lu_factor_inplace(lu, opt.pivot_eps)) {
+                        MATHLIB_THROW(core::domain_error("solve_nonlinear(): Jacobian is singular"));
+                    }
+                    for (std::size_t j = 0; j < N; ++j) {
+                        Vec e{};
+                        e[j] = static_cast<T>(1);
+                        const Vec col = mathlib::linalg::lu_solve(lu, e);
+                        for (std::size_t i = 0; i < N; ++i) H(i, j) = col[i];
+                    }
+                    need_jac = false;
+                    fresh = true;
+                }
+
+                const Vec dx = static_cast<T>(-1) * mathlib::linalg::mul(H, fx);
+
+                // Backtracking line search on ||F||^2 (Armijo condition for the Newton direction)
+                T t = static_cast<T>(1);
+                Vec xn, fn;
+                T phin{};
+                bool accepted = false;
+                for (int ls = 0; ls < 30; ++ls) {
+                    xn = x + t * dx;
+                    fn = f(xn);
+                    ++res.f_evals;
+                    phin = dot(fn, fn);
+                    if (phin <= (static_cast<T>(1) - static_cast<T>(1e-4) * t) * phi) {
+                        accepted = true;
+                        break;
+                    }
+                    t /= static_cast<T>(2);
+                }
+
+                if (!accepted) {
+                    if (!fresh) {
+                        // The approximation went stale: retry from x with a new Jacobian
+                        need_jac = true;
+                        continue;
+                    }
+                    res.stagnated = true; // no descent even with the true Jacobian
+                    break;
+                }
+
+                const Vec s = xn - x;
+                const Vec y = fn - fx;
+                const T ratio = (phi > T{}) ? std::sqrt(phin / phi) : T{};
+                const bool step_from_fresh = fresh;
+                x = xn;
+                fx = fn;
+                phi = phin;
+                fresh = false;
+
+                if (max_abs(s) <= opt.tol_x * (static_cast<T>(1) + max_abs(x))) {
+                    // A tiny step only means convergence if F is small too;
+                    // otherwise the line search has stalled
+                    if (max_abs(fx) <= opt.tol_f) {
+                        res.converged = true;
+                        ++res.iterations;
+                        break;
+                    }
+                    if (step_from_fresh) {
+                        res.stagnated = true;
+                        ++res.iterations;
+                        break;
+                    }
+                    need_jac = true;
+                    continue;
+                }
+
+                if (ratio > opt.refresh_ratio) {
+                    need_jac = true;
+                }
+                else if (opt.broyden) {
+                    // "Good" Broyden update of B, applied to H = B^-1 by
+                    // Sherman-Morrison: H += (s - H y) (s^T H) / (s^T H y)
+                    const Vec Hy = mathlib::linalg::mul(H, y);
+                    const T denom = dot(s, Hy);
+                    if (!(std::abs(denom) > opt.pivot_eps * dot(s, s))) {
+                        need_jac = true; // update would make B (nearly) singular
+                        continue;
+                    }
+                    Vec sH{};
+                    for (std::size_t i = 0; i < N; ++i)
+                        for (std::size_t j = 0; j < N; ++j)
+                            sH[j] += s[i] * H(i, j);
+                    const Vec u = s - Hy;
+                    for (std::size_t i = 0; i < N; ++i)
+                        for (std::size_t j = 0; j < N; ++j)
+                            H(i, j) += u[i] * sH[j] / denom;
+                }
+            }
+
+            res.x = x;
+            res.f_norm = max_abs(fx);
+            if (!res.converged && res.f_norm <= opt.tol_f) res.converged = true;
+            return res;
+        }
+
+    } // namespace detail
+
+    // Solve F(x) = 0 for F: R^N -> R^N, Jacobian by forward differences (N evaluations each).
+    template <typename F, std::size_t N, typename T>
+    NonlinearResult<N, T> solve_nonlinear(F f,
+        const mathlib::linalg::Vector<N, T>& x0,
+        const NonlinearOptions<T>& opt = {}) {
+        static_assert(std::is_floating_point_v<T>, "solve_nonlinear: T must be floating point");
+        if (opt.tol_f <= T{}) MATHLIB_THROW(core::domain_error("solve_nonlinear(): tol_f must be > 0"));
+
+        std::size_t extra = 0;
+        auto jac = [&](const mathlib::linalg::Vector<N, T>& x, const mathlib::linalg::Vector<N, T>& fx) {
+            extra += N;
+            return jacobian_forward(f, x, fx, opt.fd_step);
+        };
+        auto res = detail::solve_nonlinear_impl(f, jac, x0, opt);
+        res.f_evals += extra;
+        return res;
+    }
+
+    // Same, with a user-supplied (analytic or AD) Jacobian: jac(x) -> Matrix<N,N,T>.
+    template <typename F, typename J, std::size_t N, typename T>
+        requires std::is_invocable_v<J&, const mathlib::linalg::Vector<N, T>&>
+    NonlinearResult<N, T> solve_nonlinear(F f, J jac,
+        const mathlib::linalg::Vector<N, T>& x0,
+        const NonlinearOptions<T>& opt = {}) {
+        static_assert(std::is_floating_point_v<T>, "solve_nonlinear: T must be floating point");
+        if (opt.tol_f <= T{}) MATHLIB_THROW(core::domain_error("solve_nonlinear(): tol_f must be > 0"));
+
+        auto j = [&](const mathlib::linalg::Vector<N, T>& x, const mathlib::linalg::Vector<N, T>&) {
+            return jac(x);
+        };
+        return detail::solve_nonlinear_impl(f, j, x0, opt);
+    }
+
+} // namespace mathlib::calculus
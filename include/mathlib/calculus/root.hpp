@@ -3,62 +3,187 @@
 #include <cmath>
 #include <limits>
 
+#include "mathlib/core/cmath.hpp"
 #include "mathlib/core/error.hpp"
+#include "mathlib/core/expected.hpp"
+#include "mathlib/core/instrument.hpp"
 #include "mathlib/calculus/diff.hpp"
 
 namespace mathlib::calculus {
 
-    // Bisection: requires f(a) and f(b) have opposite signs.
-    template <typename F, typename T>
-    T root_bisection(F f, T a, T b,
-        T eps = static_cast<T>(1e-12),
-        std::size_t max_iter = 200) {
-        if (eps <= T{}) throw core::domain_error("root_bisection(): eps must be > 0");
-        T fa = f(a), fb = f(b);
-        if (fa == T{}) return a;
-        if (fb == T{}) return b;
-        if ((fa > T{} && fb > T{}) || (fa < T{} && fb < T{})) {
-            throw core::domain_error("root_bisection(): f(a) and f(b) must have opposite signs");
-        }
+    namespace detail {
+
+        // Shared by the throwing and try_ entry points: stores the root in x and
+        // reports bad input as a status instead of throwing.
+        template <typename F, typename T, typename Stats>
+        constexpr core::error_code root_bisection(F& f, T a, T b, T eps, std::size_t max_iter, Stats& stats, T& x) {
+            auto timer = stats.scoped_timer();
+            if (!(eps > T{})) return core::error_code::invalid_argument;
+            T fa = f(a), fb = f(b);
+            stats.add_evals(2);
+            if (fa == T{}) { x = a; return core::error_code::ok; }
+            if (fb == T{}) { x = b; return core::error_code::ok; }
+            if ((fa > T{} && fb > T{}) || (fa < T{} && fb < T{})) return core::error_code::no_sign_change;
 
-        for (std::size_t it = 0; it < max_iter; ++it) {
-            T m = (a + b) / static_cast<T>(2);
-            T fm = f(m);
+            for (std::size_t it = 0; it < max_iter; ++it) {
+                T m = (a + b) / static_cast<T>(2);
+                T fm = f(m);
+                stats.add_evals(1);
+                stats.add_iteration();
+                if constexpr (Stats::tracing) {
+                    stats.event({ "root_bisection", "iteration", it, static_cast<double>(m), static_cast<double>(fm),
+                        static_cast<double>((b - a) / static_cast<T>(2)) });
+                }
 
-            if (std::abs(fm) <= eps || (b - a) / static_cast<T>(2) <= eps) return m;
+                if (core::cmath::abs(fm) <= eps || (b - a) / static_cast<T>(2) <= eps) {
+                    stats.set_error(static_cast<double>((b - a) / static_cast<T>(2)));
+                    stats.set_converged(true);
+                    x = m;
+                    return core::error_code::ok;
+                }
 
-            if ((fa > T{} && fm > T{}) || (fa < T{} && fm < T{})) {
-                a = m; fa = fm;
+                if ((fa > T{} && fm > T{}) || (fa < T{} && fm < T{})) {
+                    a = m; fa = fm;
+                }
+                else {
+                    b = m; fb = fm;
+                }
             }
-            else {
-                b = m; fb = fm;
+            stats.set_error(static_cast<double>((b - a) / static_cast<T>(2)));
+            stats.set_converged(false);
+            x = (a + b) / static_cast<T>(2);
+            return core::error_code::ok;
+        }
+
+        template <typename F, typename T, typename Stats>
+        constexpr core::error_code root_newton(F& f, T x0, T eps, std::size_t max_iter, T h, Stats& stats, T& x) {
+            auto timer = stats.scoped_timer();
+            if (!(eps > T{}) || !(h > T{})) return core::error_code::invalid_argument;
+
+            x = x0;
+            for (std::size_t it = 0; it < max_iter; ++it) {
+                T fx = f(x);
+                stats.add_evals(1);
+                if (core::cmath::abs(fx) <= eps) {
+                    stats.set_converged(true);
+                    return core::error_code::ok;
+                }
+
+                T dfx = derivative_central<F, T>(f, x, h);
+                stats.add_evals(2);
+                if (dfx == T{}) return core::error_code::zero_derivative;
+
+                T step = fx / dfx;
+                x = x - step;
+                stats.add_iteration();
+                stats.set_error(static_cast<double>(core::cmath::abs(step)));
+                if constexpr (Stats::tracing) {
+                    stats.event({ "root_newton", "iteration", it, static_cast<double>(x), static_cast<double>(fx),
+                        static_cast<double>(core::cmath::abs(step)) });
+                }
+
+                if (core::cmath::abs(step) <= eps) {
+                    stats.set_converged(true);
+                    return core::error_code::ok;
+                }
             }
+            stats.set_converged(false);
+            return core::error_code::ok;
         }
-        return (a + b) / static_cast<T>(2);
+
+    } // namespace detail
+
+    // Bisection: requires f(a) and f(b) have opposite signs. Stats records
+    // evaluations, iterations, the final bracket half-width and whether eps
+    // was reached within max_iter.
+    template <typename F, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    constexpr T root_bisection(F f, T a, T b, T eps, std::size_t max_iter, Stats& stats) {
+        T x{};
+        switch (detail::root_bisection(f, a, b, eps, max_iter, stats, x)) {
+        case core::error_code::ok: break;
+        case core::error_code::invalid_argument:
+            MATHLIB_THROW(core::domain_error("root_bisection(): eps must be > 0"));
+        default:
+            MATHLIB_THROW(core::domain_error("root_bisection(): f(a) and f(b) must have opposite signs"));
+        }
+        return x;
+    }
+
+    template <typename F, typename T>
+    constexpr T root_bisection(F f, T a, T b,
+        T eps = static_cast<T>(1e-12),
+        std::size_t max_iter = 200) {
+        core::null_stats stats;
+        return root_bisection(f, a, b, eps, max_iter, stats);
     }
 
     // Newton: fast but needs decent initial guess; uses numeric derivative by default.
+    // Stats records evaluations (2 per derivative), iterations, the last step
+    // length and whether eps was reached within max_iter.
+    template <typename F, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    constexpr T root_newton(F f, T x0, T eps, std::size_t max_iter, T h, Stats& stats) {
+        T x{};
+        switch (detail::root_newton(f, x0, eps, max_iter, h, stats, x)) {
+        case core::error_code::ok: break;
+        case core::error_code::invalid_argument:
+            MATHLIB_THROW(core::domain_error("root_newton(): eps and h must be > 0"));
+        default:
+            MATHLIB_THROW(core::domain_error("root_newton(): derivative is zero"));
+        }
+        return x;
+    }
+
     template <typename F, typename T>
-    T root_newton(F f, T x0,
+    constexpr T root_newton(F f, T x0,
         T eps = static_cast<T>(1e-12),
         std::size_t max_iter = 50,
         T h = static_cast<T>(1e-6)) {
-        if (eps <= T{}) throw core::domain_error("root_newton(): eps must be > 0");
-
-        T x = x0;
-        for (std::size_t it = 0; it < max_iter; ++it) {
-            T fx = f(x);
-            if (std::abs(fx) <= eps) return x;
+        core::null_stats stats;
+        return root_newton(f, x0, eps, max_iter, h, stats);
+    }
 
-            T dfx = derivative_central<F, T>(f, x, h);
-            if (dfx == T{}) throw core::domain_error("root_newton(): derivative is zero");
+    // Non-throwing variants: bad arguments give invalid_argument, an unbracketed
+    // interval no_sign_change and a flat Newton step zero_derivative. Running
+    // out of iterations is not an error; pass stats to see whether eps was met.
+    template <typename F, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    core::expected<T, core::error_code> try_root_bisection(F f, T a, T b, T eps, std::size_t max_iter,
+        Stats& stats) noexcept {
+        T x{};
+        if (auto c = detail::root_bisection(f, a, b, eps, max_iter, stats, x); c != core::error_code::ok) {
+            return core::fail(c);
+        }
+        return x;
+    }
 
-            T step = fx / dfx;
-            x = x - step;
+    template <typename F, typename T>
+    core::expected<T, core::error_code> try_root_bisection(F f, T a, T b,
+        T eps = static_cast<T>(1e-12),
+        std::size_t max_iter = 200) noexcept {
+        core::null_stats stats;
+        return try_root_bisection(f, a, b, eps, max_iter, stats);
+    }
 
-            if (std::abs(step) <= eps) return x;
+    template <typename F, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    core::expected<T, core::error_code> try_root_newton(F f, T x0, T eps, std::size_t max_iter, T h,
+        Stats& stats) noexcept {
+        T x{};
+        if (auto c = detail::root_newton(f, x0, eps, max_iter, h, stats, x); c != core::error_code::ok) {
+            return core::fail(c);
         }
         return x;
     }
 
+    template <typename F, typename T>
+    core::expected<T, core::error_code> try_root_newton(F f, T x0,
+        T eps = static_cast<T>(1e-12),
+        std::size_t max_iter = 50,
+        T h = static_cast<T>(1e-6)) noexcept {
+        core::null_stats stats;
+        return try_root_newton(f, x0, eps, max_iter, h, stats);
+    }
+
 } // namespace mathlib::calculus
@@ -3,6 +3,8 @@
 #include <type_traits>
 #include <algorithm>
 
+#include "mathlib/core/cmath.hpp"
+
 namespace mathlib::core {
 
     // Robust float compare: abs + relative tolerance
@@ -15,8 +17,8 @@ namespace mathlib::core {
         // Handle infinities exactly
         if (a == b) return true;
 
-        const T diff = std::abs(a - b);
-        const T norm = std::max(std::abs(a), std::abs(b));
+        const T diff = cmath::abs(a - b);
+        const T norm = std::max(cmath::abs(a), cmath::abs(b));
         return diff <= std::max(abs_tol, rel_tol * norm);
     }
 
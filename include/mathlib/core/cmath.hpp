@@ -0,0 +1,113 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "mathlib/core/constants.hpp"
+
+// constexpr stand-ins for the <cmath> functions the library needs. In a
+// constant expression they use series/iterations accurate to a few ulp;
+// at run time they forward to <cmath>, so run-time results are unchanged.
+namespace mathlib::core::cmath {
+
+    template <typename T>
+    constexpr T abs(T x) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (x == T{}) return T{}; // -0.0 -> +0.0
+        }
+        return x < T{} ? -x : x;
+    }
+
+    template <typename T>
+    constexpr bool isnan(T x) noexcept {
+        return x != x;
+    }
+
+    template <typename T>
+    constexpr bool isinf(T x) noexcept {
+        return x == std::numeric_limits<T>::infinity() || x == -std::numeric_limits<T>::infinity();
+    }
+
+    template <typename T>
+    constexpr T sqrt(T x) noexcept {
+        static_assert(std::is_floating_point_v<T>, "cmath::sqrt: T must be floating point");
+        if (!std::is_constant_evaluated()) return std::sqrt(x);
+        if (isnan(x) || x < T{}) return std::numeric_limits<T>::quiet_NaN();
+        if (x == T{} || isinf(x)) return x;
+
+        // scale into [1, 4) by powers of 4, then Newton from a guess in [1, 2)
+        T scale = 1;
+        while (x >= 4) { x /= 4; scale *= 2; }
+        while (x < 1) { x *= 4; scale /= 2; }
+        T g = (x + 1) / 2;
+        for (int i = 0; i < 8; ++i) g = (g + x / g) / 2;
+        return g * scale;
+    }
+
+    template <typename T>
+    constexpr T exp(T x) noexcept {
+        static_assert(std::is_floating_point_v<T>, "cmath::exp: T must be floating point");
+        if (!std::is_constant_evaluated()) return std::exp(x);
+        if (isnan(x)) return x;
+        constexpr T ln2 = static_cast<T>(0.693147180559945309417232121458176568L);
+        if (x > std::numeric_limits<T>::max_exponent * ln2) return std::numeric_limits<T>::infinity();
+        if (x < (std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits) * ln2) return T{};
+
+        // x = k ln2 + r with |r| <= ln2 / 2; Taylor series for e^r
+        const long k = static_cast<long>(x / ln2 + (x < T{} ? T(-0.5) : T(0.5)));
+        const T r = x - static_cast<T>(k) * ln2;
+        T term = 1, sum = 1;
+        for (int n = 1; n < 30; ++n) {
+            term *= r / static_cast<T>(n);
+            sum += term;
+        }
+        // scale by 2^k one factor at a time (ldexp is not constexpr), so
+        // only a result that really overflows does
+        const T two = (k < 0) ? T(0.5) : T(2);
+        for (long i = 0; i < (k < 0 ? -k : k); ++i) sum *= two;
+        return sum;
+    }
+
+    namespace detail {
+
+        // x mod 2pi into [-pi, pi]
+        template <typename T>
+        constexpr T reduce_angle(T x) noexcept {
+            constexpr T two_pi = 2 * pi_v<T>;
+            const T k = static_cast<T>(static_cast<long long>(x / two_pi + (x < T{} ? T(-0.5) : T(0.5))));
+            return x - k * two_pi;
+        }
+
+        // sum_{n>=0} (-1)^n x^(2n+first) / (2n+first)!
+        template <typename T>
+        constexpr T alternating_series(T x, int first) noexcept {
+            T term = first == 0 ? T(1) : x;
+            T sum = term;
+            for (int n = first + 1; n < first + 60; n += 2) {
+                term *= -x * x / (static_cast<T>(n) * static_cast<T>(n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+    } // namespace detail
+
+    // Reduced by 2pi in T, so accuracy degrades for |x| much larger than 1e3.
+    template <typename T>
+    constexpr T sin(T x) noexcept {
+        static_assert(std::is_floating_point_v<T>, "cmath::sin: T must be floating point");
+        if (!std::is_constant_evaluated()) return std::sin(x);
+        if (isnan(x) || isinf(x)) return std::numeric_limits<T>::quiet_NaN();
+        return detail::alternating_series(detail::reduce_angle(x), 1);
+    }
+
+    template <typename T>
+    constexpr T cos(T x) noexcept {
+        static_assert(std::is_floating_point_v<T>, "cmath::cos: T must be floating point");
+        if (!std::is_constant_evaluated()) return std::cos(x);
+        if (isnan(x) || isinf(x)) return std::numeric_limits<T>::quiet_NaN();
+        return detail::alternating_series(detail::reduce_angle(x), 0);
+    }
+
+} // namespace mathlib::core::cmath
@@ -1,9 +1,60 @@
 #pragma once
+#include <cstdio>
+#include <cstdlib>
 #include <stdexcept>
 #include <string>
 
+// Exceptions are used when the translation unit is compiled with them. With
+// -fno-exceptions, MATHLIB_THROW prints the message and aborts instead; use
+// the noexcept try_* variants (returning core::expected) on such builds.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define MATHLIB_HAS_EXCEPTIONS 1
+#else
+#define MATHLIB_HAS_EXCEPTIONS 0
+#endif
+
+#if MATHLIB_HAS_EXCEPTIONS
+#define MATHLIB_THROW(...) throw __VA_ARGS__
+#else
+#define MATHLIB_THROW(...) ::mathlib::core::detail::fatal_error(__VA_ARGS__)
+#endif
+
 namespace mathlib::core {
 
+    namespace detail {
+
+        [[noreturn]] inline void fatal_error(const std::exception& e) noexcept {
+            std::fputs(e.what(), stderr);
+            std::fputc('\n', stderr);
+            std::abort();
+        }
+
+    } // namespace detail
+
+    // Status of the noexcept try_* variants (see core/expected.hpp).
+    enum class error_code {
+        ok = 0,
+        invalid_argument,   // a parameter is out of range (h <= 0, eps <= 0, ...)
+        singular_matrix,    // pivot below pivot_eps
+        zero_derivative,    // Newton step undefined
+        no_sign_change,     // bracket does not enclose a root
+        step_underflow,     // adaptive step fell below h_min
+        too_many_steps,     // max_steps exhausted
+    };
+
+    constexpr const char* to_string(error_code c) noexcept {
+        switch (c) {
+        case error_code::ok: return "ok";
+        case error_code::invalid_argument: return "invalid argument";
+        case error_code::singular_matrix: return "matrix is singular or ill-conditioned";
+        case error_code::zero_derivative: return "derivative is zero";
+        case error_code::no_sign_change: return "f(a) and f(b) must have opposite signs";
+        case error_code::step_underflow: return "step underflow (h < h_min)";
+        case error_code::too_many_steps: return "too many steps";
+        }
+        return "unknown error";
+    }
+
     struct dimension_error : std::logic_error {
         explicit dimension_error(const std::string& msg)
             : std::logic_error("mathlib dimension error: " + msg) {}
@@ -14,5 +65,10 @@ namespace mathlib::core {
             : std::domain_error("mathlib domain error: " + msg) {}
     };
 
+    struct io_error : std::runtime_error {
+        explicit io_error(const std::string& msg)
+            : std::runtime_error("mathlib io error: " + msg) {}
+    };
+
 } // namespace mathlib::core
 #pragma once
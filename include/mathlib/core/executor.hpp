@@ -0,0 +1,217 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mathlib/core/error.hpp"
+
+namespace mathlib::core {
+
+    // An executor runs fn(i) for every i in [0, n) and returns when all calls are done.
+    template <typename E>
+    concept executor = requires(E & e, std::size_t n) {
+        { e.concurrency() } -> std::convertible_to<std::size_t>;
+        e.bulk(n, [](std::size_t) {});
+    };
+
+    // Serial executor: everything runs on the calling thread (library default).
+    struct inline_executor {
+        constexpr std::size_t concurrency() const noexcept { return 1; }
+
+        template <typename Fn>
+        void bulk(std::size_t n, Fn&& fn) {
+            for (std::size_t i = 0; i < n; ++i) fn(i);
+        }
+    };
+
+    // Work-stealing thread pool. Each worker owns a deque: it pops its own work
+    // LIFO and steals FIFO from the others. A thread waiting in bulk() keeps
+    // executing queued tasks, so nested bulk() calls from inside tasks are safe.
+    class thread_pool {
+    public:
+        explicit thread_pool(std::size_t workers = default_workers())
+            : queues_(workers) {
+            threads_.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i) {
+                threads_.emplace_back([this, i] { worker_loop(i); });
+            }
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lk(sleep_m_);
+                stop_ = true;
+            }
+            sleep_cv_.notify_all();
+            for (auto& t : threads_) t.join();
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        // Workers plus the calling thread, which helps while it waits
+        std::size_t concurrency() const noexcept { return threads_.size() + 1; }
+
+        static std::size_t default_workers() {
+            const unsigned hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 1;
+        }
+
+        template <typename Fn>
+        void bulk(std::size_t n, Fn&& fn) {
+            if (n == 0) return;
+            if (threads_.empty() || n == 1) {
+                for (std::size_t i = 0; i < n; ++i) fn(i);
+                return;
+            }
+
+            using FnT = std::remove_reference_t<Fn>;
+            struct job {
+                FnT* fn;
+                std::atomic<std::size_t> remaining;
+                std::mutex error_m;
+                std::exception_ptr error;
+            };
+            job j{ &fn, n, {}, nullptr };
+
+            auto run = [](void* ctx, std::size_t b, std::size_t e) {
+                auto* jp = static_cast<job*>(ctx);
+#if MATHLIB_HAS_EXCEPTIONS
+                try {
+                    for (std::size_t i = b; i < e; ++i) (*jp->fn)(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lk(jp->error_m);
+                    if (!jp->error) jp->error = std::current_exception();
+                }
+#else
+                for (std::size_t i = b; i < e; ++i) (*jp->fn)(i);
+#endif
+                jp->remaining.fetch_sub(e - b, std::memory_order_acq_rel);
+            };
+
+            // A few ranges per thread so idle workers have something to steal
+            const std::size_t parts = std::min(n, 4 * concurrency());
+            pending_.fetch_add(parts, std::memory_order_acq_rel);
+            for (std::size_t p = 0; p < parts; ++p) {
+                push(task{ run, &j, p * n / parts, (p + 1) * n / parts });
+            }
+            {
+                std::lock_guard<std::mutex> lk(sleep_m_);
+            }
+            sleep_cv_.notify_all();
+
+            while (j.remaining.load(std::memory_order_acquire) != 0) {
+                if (!run_one(self_index())) std::this_thread::yield();
+            }
+#if MATHLIB_HAS_EXCEPTIONS
+            if (j.error) std::rethrow_exception(j.error);
+#endif
+        }
+
+    private:
+        struct task {
+            void (*run)(void*, std::size_t, std::size_t) = nullptr;
+            void* ctx = nullptr;
+            std::size_t begin = 0, end = 0;
+        };
+
+        struct queue {
+            std::mutex m;
+            std::deque<task> q;
+        };
+
+        static thread_pool*& tl_owner() {
+            static thread_local thread_pool* owner = nullptr;
+            return owner;
+        }
+        static std::size_t& tl_index() {
+            static thread_local std::size_t index = 0;
+            return index;
+        }
+
+        // Own queue index for workers, a rotating start for outside threads
+        std::size_t self_index() {
+            if (tl_owner() == this) return tl_index();
+            return next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        }
+
+        void push(const task& t) {
+            auto& qu = queues_[self_index()];
+            std::lock_guard<std::mutex> lk(qu.m);
+            qu.q.push_back(t);
+        }
+
+        bool pop(std::size_t i, bool own, task& t) {
+            auto& qu = queues_[i];
+            std::lock_guard<std::mutex> lk(qu.m);
+            if (qu.q.empty()) return false;
+            if (own) {
+                t = qu.q.back();
+                qu.q.pop_back();
+            }
+            else {
+                t = qu.q.front();
+                qu.q.pop_front();
+            }
+            return true;
+        }
+
+        bool run_one(std::size_t home) {
+            task t;
+            const std::size_t k = queues_.size();
+            bool found = pop(home, tl_owner() == this, t);
+            for (std::size_t s = 1; !found && s < k; ++s) found = pop((home + s) % k, false, t);
+            if (!found) return false;
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            t.run(t.ctx, t.begin, t.end);
+            return true;
+        }
+
+        void worker_loop(std::size_t i) {
+            tl_owner() = this;
+            tl_index() = i;
+            for (;;) {
+                if (run_one(i)) continue;
+                std::unique_lock<std::mutex> lk(sleep_m_);
+                sleep_cv_.wait(lk, [this] { return stop_ || pending_.load(std::memory_order_acquire) > 0; });
+                if (stop_ && pending_.load(std::memory_order_acquire) == 0) return;
+            }
+        }
+
+        std::vector<queue> queues_;
+        std::vector<std::thread> threads_;
+        std::atomic<std::size_t> pending_{ 0 };
+        std::atomic<std::size_t> next_{ 0 };
+        std::mutex sleep_m_;
+        std::condition_variable sleep_cv_;
+        bool stop_ = false;
+    };
+
+    // Deterministic reduction: partials[i] = map(i) for a fixed number of chunks,
+    // then combined pairwise in a fixed tree order. The result depends only on
+    // `chunks`, never on the executor or thread count.
+    template <typename R, typename Exec, typename Map, typename Combine>
+        requires executor<std::remove_cvref_t<Exec>>
+    R parallel_reduce(Exec&& exec, std::size_t chunks, Map map, Combine combine) {
+        std::vector<R> partial(chunks);
+        exec.bulk(chunks, [&](std::size_t i) { partial[i] = map(i); });
+        for (std::size_t stride = 1; stride < chunks; stride *= 2) {
+            for (std::size_t i = 0; i + stride < chunks; i += 2 * stride) {
+                partial[i] = combine(partial[i], partial[i + stride]);
+            }
+        }
+        return chunks ? partial[0] : R{};
+    }
+
+} // namespace mathlib::core
@@ -0,0 +1,79 @@
+#pragma once
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "mathlib/core/error.hpp"
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+namespace mathlib::core {
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+
+    template <typename T, typename E>
+    using expected = std::expected<T, E>;
+
+    template <typename E>
+    using unexpected = std::unexpected<E>;
+
+#else
+
+    // Minimal stand-in for std::expected (C++23) covering what the try_*
+    // functions need. value() on an error is a fatal error.
+    template <typename E>
+    class unexpected {
+    public:
+        constexpr explicit unexpected(E e) noexcept(std::is_nothrow_move_constructible_v<E>) : e_(std::move(e)) {}
+        constexpr const E& error() const noexcept { return e_; }
+
+    private:
+        E e_;
+    };
+
+    template <typename T, typename E>
+    class expected {
+    public:
+        using value_type = T;
+        using error_type = E;
+
+        constexpr expected(const T& v) : v_(v) {}
+        constexpr expected(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>) : v_(std::move(v)) {}
+        constexpr expected(const unexpected<E>& u) : e_(u.error()) {}
+
+        constexpr bool has_value() const noexcept { return v_.has_value(); }
+        constexpr explicit operator bool() const noexcept { return has_value(); }
+
+        constexpr const T& operator*() const& noexcept { return *v_; }
+        constexpr T& operator*() & noexcept { return *v_; }
+        constexpr T&& operator*() && noexcept { return std::move(*v_); }
+        constexpr const T* operator->() const noexcept { return &*v_; }
+        constexpr T* operator->() noexcept { return &*v_; }
+
+        constexpr const T& value() const& {
+            if (!v_) detail::fatal_error(domain_error("expected::value(): no value"));
+            return *v_;
+        }
+        constexpr T& value() & {
+            if (!v_) detail::fatal_error(domain_error("expected::value(): no value"));
+            return *v_;
+        }
+
+        template <typename U>
+        constexpr T value_or(U&& u) const& { return v_ ? *v_ : static_cast<T>(std::forward<U>(u)); }
+
+        constexpr const E& error() const noexcept { return e_; }
+
+    private:
+        std::optional<T> v_;
+        E e_{};
+    };
+
+#endif
+
+    // Shorthand for returning an error from a try_* function.
+    constexpr unexpected<error_code> fail(error_code c) noexcept { return unexpected<error_code>(c); }
+
+} // namespace mathlib::core
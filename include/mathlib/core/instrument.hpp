@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+namespace mathlib::core {
+
+    // One per-iteration record streamed by trace_stats. Fields that do not
+    // apply to a solver are left at zero.
+    struct trace_event {
+        const char* source = "";   // e.g. "root_newton", "solve_rk45"
+        const char* kind = "";     // "iteration", "step", "leaf", "pivot", ...
+        std::size_t index = 0;     // iteration, step number or depth
+        double x = 0;              // iterate, abscissa or time
+        double value = 0;          // residual, step size or partial result
+        double error = 0;          // error estimate where available
+    };
+
+    // Stats policies are passed by reference as the last argument of the
+    // instrumented overloads. `enabled` gates all bookkeeping and `tracing`
+    // gates event construction, so null_stats compiles to nothing.
+    template <typename S>
+    concept stats_policy = requires(S& s, std::size_t n, double v, const trace_event& e) {
+        { S::enabled } -> std::convertible_to<bool>;
+        { S::tracing } -> std::convertible_to<bool>;
+        s.add_evals(n);
+        s.add_iteration();
+        s.add_accepted();
+        s.add_rejected(n);
+        s.note_depth(n);
+        s.note_pivot_growth(v);
+        s.set_error(v);
+        s.add_error(v);
+        s.set_converged(true);
+        s.event(e);
+        s.scoped_timer();
+    };
+
+    struct null_stats {
+        static constexpr bool enabled = false;
+        static constexpr bool tracing = false;
+
+        // user-provided destructor: `auto timer = stats.scoped_timer();` is
+        // then not flagged as unused
+        struct timer {
+            constexpr ~timer() {}
+        };
+
+        constexpr void add_evals(std::size_t) noexcept {}
+        constexpr void add_iteration() noexcept {}
+        constexpr void add_accepted() noexcept {}
+        constexpr void add_rejected(std::size_t = 1) noexcept {}
+        constexpr void note_depth(std::size_t) noexcept {}
+        constexpr void note_pivot_growth(double) noexcept {}
+        constexpr void set_error(double) noexcept {}
+        constexpr void add_error(double) noexcept {}
+        constexpr void set_converged(bool) noexcept {}
+        constexpr void event(const trace_event&) noexcept {}
+        constexpr timer scoped_timer() noexcept { return {}; }
+    };
+
+    // Counters and wall time for one or more calls (they accumulate; reset()
+    // between calls for per-call metrics).
+    struct basic_stats {
+        static constexpr bool enabled = true;
+        static constexpr bool tracing = false;
+
+        std::size_t evals = 0;          // calls of the user function
+        std::size_t iterations = 0;
+        std::size_t accepted = 0;       // accepted steps / intervals
+        std::size_t rejected = 0;
+        std::size_t max_depth = 0;      // recursion depth reached
+        double error_estimate = 0;      // final error estimate
+        double pivot_growth = 1;        // max |U| / max |A| in eliminations
+        bool converged = true;          // false if a limit was hit
+        double wall_seconds = 0;
+
+        class timer {
+        public:
+            explicit timer(double& acc) : acc_(&acc), t0_(std::chrono::steady_clock::now()) {}
+            timer(timer&& o) noexcept : acc_(std::exchange(o.acc_, nullptr)), t0_(o.t0_) {}
+            timer(const timer&) = delete;
+            timer& operator=(const timer&) = delete;
+            timer& operator=(timer&&) = delete;
+            ~timer() {
+                if (acc_) *acc_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0_).count();
+            }
+
+        private:
+            double* acc_;
+            std::chrono::steady_clock::time_point t0_;
+        };
+
+        void add_evals(std::size_t n) noexcept { evals += n; }
+        void add_iteration() noexcept { ++iterations; }
+        void add_accepted() noexcept { ++accepted; }
+        void add_rejected(std::size_t n = 1) noexcept { rejected += n; }
+        void note_depth(std::size_t d) noexcept { max_depth = std::max(max_depth, d); }
+        void note_pivot_growth(double g) noexcept { pivot_growth = std::max(pivot_growth, g); }
+        void set_error(double e) noexcept { error_estimate = e; }
+        void add_error(double e) noexcept { error_estimate += e; }
+        void set_converged(bool c) noexcept { converged = c; }
+        void event(const trace_event&) noexcept {}
+        timer scoped_timer() { return timer(wall_seconds); }
+
+        void reset() noexcept { *this = basic_stats{}; }
+    };
+
+    // basic_stats that also streams every event to hook(const trace_event&).
+    template <typename Hook>
+    struct trace_stats : basic_stats {
+        static constexpr bool tracing = true;
+
+        Hook hook;
+
+        explicit trace_stats(Hook h) : hook(std::move(h)) {}
+
+        void event(const trace_event& e) { hook(e); }
+        void reset() noexcept { static_cast<basic_stats&>(*this) = basic_stats{}; }
+    };
+
+} // namespace mathlib::core
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "mathlib/core/error.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mathlib::core {
+
+    // Read-only or private copy-on-write memory mapping of a whole file
+    // (move-only, unmapped on destruction). Writes through a copy-on-write
+    // mapping are never carried back to the file.
+    class mapped_file {
+    public:
+        enum class mode { read_only, copy_on_write };
+        enum class access { normal, sequential, random, will_need };
+
+        mapped_file() = default;
+
+        explicit mapped_file(const std::string& path, mode m = mode::read_only) : mode_(m) {
+#if defined(_WIN32)
+            file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE) MATHLIB_THROW(io_error("mapped_file(): cannot open " + path));
+            LARGE_INTEGER sz;
+            if (!GetFileSizeEx(file_, &sz)) {
+                close();
+                MATHLIB_THROW(io_error("mapped_file(): cannot stat " + path));
+            }
+            size_ = static_cast<std::size_t>(sz.QuadPart);
+            if (size_ == 0) return;
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_) {
+                data_ = MapViewOfFile(mapping_, m == mode::read_only ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0);
+            }
+            if (!data_) {
+                close();
+                MATHLIB_THROW(io_error("mapped_file(): cannot map " + path));
+            }
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) MATHLIB_THROW(io_error("mapped_file(): cannot open " + path));
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                MATHLIB_THROW(io_error("mapped_file(): cannot stat " + path));
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ != 0) {
+                const int prot = m == mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+                void* p = ::mmap(nullptr, size_, prot, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    ::close(fd);
+                    MATHLIB_THROW(io_error("mapped_file(): cannot map " + path));
+                }
+                data_ = p;
+            }
+            ::close(fd); // the mapping keeps the file alive
+#endif
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& o) noexcept { swap(o); }
+        mapped_file& operator=(mapped_file&& o) noexcept {
+            if (this != &o) {
+                close();
+                swap(o);
+            }
+            return *this;
+        }
+
+        ~mapped_file() { close(); }
+
+        const std::byte* data() const noexcept { return static_cast<const std::byte*>(data_); }
+        std::size_t size() const noexcept { return size_; }
+        bool writable() const noexcept { return mode_ == mode::copy_on_write; }
+
+        // Only valid for copy-on-write mappings.
+        std::byte* mutable_data() {
+            if (!writable()) MATHLIB_THROW(domain_error("mapped_file::mutable_data(): mapping is read-only"));
+            return static_cast<std::byte*>(data_);
+        }
+
+        // Paging hint for the whole mapping (no-op where unsupported).
+        void advise(access a) const noexcept {
+#if !defined(_WIN32)
+            if (!data_) return;
+            int adv = MADV_NORMAL;
+            switch (a) {
+            case access::sequential: adv = MADV_SEQUENTIAL; break;
+            case access::random: adv = MADV_RANDOM; break;
+            case access::will_need: adv = MADV_WILLNEED; break;
+            default: break;
+            }
+            ::madvise(data_, size_, adv);
+#else
+            (void)a;
+#endif
+        }
+
+    private:
+        void swap(mapped_file& o) noexcept {
+            std::swap(data_, o.data_);
+            std::swap(size_, o.size_);
+            std::swap(mode_, o.mode_);
+#if defined(_WIN32)
+            std::swap(file_, o.file_);
+            std::swap(mapping_, o.mapping_);
+#endif
+        }
+
+        void close() noexcept {
+#if defined(_WIN32)
+            if (data_) UnmapViewOfFile(data_);
+            if (mapping_) CloseHandle(mapping_);
+            if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            if (data_) ::munmap(data_, size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        void* data_ = nullptr;
+        std::size_t size_ = 0;
+        mode mode_ = mode::read_only;
+#if defined(_WIN32)
+        HANDLE file_ = INVALID_HANDLE_VALUE;
+        HANDLE mapping_ = nullptr;
+#endif
+    };
+
+} // namespace mathlib::core
@@ -0,0 +1,113 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+namespace mathlib::core {
+
+    // Forwards to an upstream resource and counts what passes through.
+    // Useful as the upstream of an arena to check for steady-state heap use.
+    class counting_resource : public std::pmr::memory_resource {
+    public:
+        explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : upstream_(upstream) {}
+
+        std::size_t allocations() const noexcept { return allocations_.load(std::memory_order_relaxed); }
+        std::size_t deallocations() const noexcept { return deallocations_.load(std::memory_order_relaxed); }
+        std::size_t bytes_in_use() const noexcept { return in_use_.load(std::memory_order_relaxed); }
+        std::size_t peak_bytes() const noexcept { return peak_.load(std::memory_order_relaxed); }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t align) override {
+            void* p = upstream_->allocate(bytes, align);
+            allocations_.fetch_add(1, std::memory_order_relaxed);
+            const std::size_t now = in_use_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            std::size_t peak = peak_.load(std::memory_order_relaxed);
+            while (now > peak && !peak_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+            return p;
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+            upstream_->deallocate(p, bytes, align);
+            deallocations_.fetch_add(1, std::memory_order_relaxed);
+            in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+
+        std::pmr::memory_resource* upstream_;
+        std::atomic<std::size_t> allocations_{ 0 };
+        std::atomic<std::size_t> deallocations_{ 0 };
+        std::atomic<std::size_t> in_use_{ 0 };
+        std::atomic<std::size_t> peak_{ 0 };
+    };
+
+    // Per-request monotonic arena: allocation is a pointer bump, deallocation
+    // is free, and reset() reclaims everything at once. The initial block is
+    // reused across requests; if a request overflowed it, reset() grows the
+    // block to the high-water mark so later requests stay off the upstream.
+    // Not thread-safe: use one arena per request/thread.
+    class request_arena : public std::pmr::memory_resource {
+    public:
+        explicit request_arena(std::size_t initial_bytes = 64 * 1024,
+            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : upstream_(upstream) {
+            rebuild(std::max<std::size_t>(initial_bytes, 256));
+        }
+
+        request_arena(const request_arena&) = delete;
+        request_arena& operator=(const request_arena&) = delete;
+
+        ~request_arena() override {
+            mono_.reset();
+            upstream_->deallocate(block_, capacity_, alignof(std::max_align_t));
+        }
+
+        void reset() {
+            if (used_ > capacity_) {
+                mono_.reset();
+                upstream_->deallocate(block_, capacity_, alignof(std::max_align_t));
+                rebuild(used_ + used_ / 2);
+            }
+            else {
+                mono_->release();
+            }
+            used_ = 0;
+        }
+
+        std::size_t capacity() const noexcept { return capacity_; }
+        std::size_t used() const noexcept { return used_; }
+
+    private:
+        void rebuild(std::size_t bytes) {
+            capacity_ = bytes;
+            block_ = upstream_->allocate(capacity_, alignof(std::max_align_t));
+            mono_.emplace(block_, capacity_, upstream_);
+        }
+
+        void* do_allocate(std::size_t bytes, std::size_t align) override {
+            used_ += bytes + align - 1; // upper bound including padding
+            return mono_->allocate(bytes, align);
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+
+        std::pmr::memory_resource* upstream_;
+        void* block_ = nullptr;
+        std::size_t capacity_ = 0;
+        std::size_t used_ = 0;
+        std::optional<std::pmr::monotonic_buffer_resource> mono_;
+    };
+
+    // Pool resource private to the calling thread (no locking, no contention).
+    // Memory returned to it is recycled for later requests on the same thread.
+    inline std::pmr::memory_resource* thread_local_pool() {
+        thread_local std::pmr::unsynchronized_pool_resource pool;
+        return &pool;
+    }
+
+} // namespace mathlib::core
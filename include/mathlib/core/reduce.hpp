@@ -0,0 +1,141 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "mathlib/core/cmath.hpp"
+
+namespace mathlib::core {
+
+    // Summation policies for reduce_sum.
+    //
+    // pairwise_sum: blocks of up to `block` terms are summed into `lanes`
+    // independent accumulators (no loop-carried add chain, so the compiler can
+    // keep them in SIMD registers), combined as a tree; larger ranges are split
+    // in half recursively. Rounding error grows like O(log n) instead of O(n).
+    //
+    // neumaier_sum: compensated (Kahan-Babuska-Neumaier) summation with a few
+    // interleaved accumulators per block. The result is close to correctly
+    // rounded independent of n, at roughly 4x the adds; scalar floating-point
+    // terms only.
+    struct pairwise_sum {
+        static constexpr std::size_t lanes = 8;
+        static constexpr std::size_t block = 128;
+    };
+
+    struct neumaier_sum {
+        static constexpr std::size_t lanes = 4;
+        static constexpr std::size_t block = 1024;
+    };
+
+    template <typename S>
+    concept summation_policy = std::same_as<S, pairwise_sum> || std::same_as<S, neumaier_sum>;
+
+    namespace detail {
+
+        // n <= pairwise_sum::block terms starting at lo
+        template <typename V, typename Term>
+        constexpr V pairwise_block(std::size_t lo, std::size_t n, Term& term) {
+            constexpr std::size_t L = pairwise_sum::lanes;
+            if (n <= L) {
+                // too short for lanes to pay off; also keeps tiny fixed-size
+                // dot products in plain left-to-right order
+                V s{};
+                for (std::size_t i = 0; i < n; ++i) s = s + term(lo + i);
+                return s;
+            }
+            V acc[L]{};
+            std::size_t i = 0;
+            for (; i + L <= n; i += L) {
+                for (std::size_t j = 0; j < L; ++j) acc[j] = acc[j] + term(lo + i + j);
+            }
+            for (std::size_t j = 0; i + j < n; ++j) acc[j] = acc[j] + term(lo + i + j);
+            for (std::size_t w = L / 2; w > 0; w /= 2) {
+                for (std::size_t j = 0; j < w; ++j) acc[j] = acc[j] + acc[j + w];
+            }
+            return acc[0];
+        }
+
+        template <typename V, typename Term>
+        constexpr V pairwise_reduce(std::size_t lo, std::size_t n, Term& term) {
+            if (n <= pairwise_sum::block) return pairwise_block<V>(lo, n, term);
+            // split on a lane boundary so both halves run full lanes
+            const std::size_t half = (n / 2) - (n / 2) % pairwise_sum::lanes;
+            return pairwise_reduce<V>(lo, half, term) + pairwise_reduce<V>(lo + half, n - half, term);
+        }
+
+        // s + c accumulates sum + x exactly up to the final rounding
+        template <typename T>
+        constexpr void neumaier_add(T& s, T& c, T x) {
+            const T t = s + x;
+            const bool s_big = cmath::abs(s) >= cmath::abs(x);
+            const T big = s_big ? s : x;
+            const T small = s_big ? x : s;
+            c += (big - t) + small;
+            s = t;
+        }
+
+        template <typename V>
+        struct compensated {
+            V s{}, c{}; // value is s + c
+        };
+
+        // Blocks keep each running compensation small (n * eps << 1 per
+        // block); block results are merged pairwise with exact two-sums.
+        template <typename V, typename Term>
+        constexpr compensated<V> neumaier_reduce(std::size_t lo, std::size_t n, Term& term) {
+            static_assert(std::is_floating_point_v<V>, "neumaier_sum: terms must be floating point");
+            constexpr std::size_t L = neumaier_sum::lanes;
+            if (n > neumaier_sum::block) {
+                const std::size_t half = (n / 2) - (n / 2) % L;
+                const compensated<V> l = neumaier_reduce<V>(lo, half, term);
+                const compensated<V> r = neumaier_reduce<V>(lo + half, n - half, term);
+                compensated<V> out{ l.s, l.c + r.c };
+                neumaier_add(out.s, out.c, r.s);
+                return out;
+            }
+
+            V s[L]{}, c[L]{};
+            std::size_t i = 0;
+            for (; i + L <= n; i += L) {
+                for (std::size_t j = 0; j < L; ++j) neumaier_add(s[j], c[j], static_cast<V>(term(lo + i + j)));
+            }
+            for (std::size_t j = 0; i + j < n; ++j) neumaier_add(s[j], c[j], static_cast<V>(term(lo + i + j)));
+
+            compensated<V> out;
+            for (std::size_t j = 0; j < L; ++j) {
+                neumaier_add(out.s, out.c, s[j]);
+                out.c += c[j];
+            }
+            return out;
+        }
+
+    } // namespace detail
+
+    // sum_{i < n} term(i). term is called once per index in increasing order;
+    // the grouping of the additions depends only on n, so results are
+    // reproducible.
+    template <typename Term, typename Sum = pairwise_sum>
+        requires summation_policy<Sum>
+    constexpr auto reduce_sum(std::size_t n, Term&& term, Sum = {}) {
+        using V = std::remove_cvref_t<decltype(term(std::size_t{}))>;
+        if constexpr (std::is_same_v<Sum, neumaier_sum>) {
+            const detail::compensated<V> r = detail::neumaier_reduce<V>(0, n, term);
+            return r.s + r.c;
+        }
+        else {
+            // the common short case stays free of the recursive call
+            if (n <= pairwise_sum::block) return detail::pairwise_block<V>(0, n, term);
+            return detail::pairwise_reduce<V>(0, n, term);
+        }
+    }
+
+    // sum_{i < n} a[i * sa] * b[i * sb]
+    template <typename T, typename Sum = pairwise_sum>
+        requires summation_policy<Sum>
+    constexpr T reduce_dot(const T* a, const T* b, std::size_t n, std::size_t sa = 1, std::size_t sb = 1, Sum sum = {}) {
+        return reduce_sum(n, [a, b, sa, sb](std::size_t i) { return a[i * sa] * b[i * sb]; }, sum);
+    }
+
+} // namespace mathlib::core
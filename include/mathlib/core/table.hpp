@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "mathlib/core/error.hpp"
+
+namespace mathlib::core {
+
+    // f sampled at N equally spaced points a, ..., b (both ends included).
+    // With a constexpr f this is evaluated by the compiler:
+    //   static constexpr auto area = core::constexpr_table<256>([](double x) {
+    //       auto bell = [](double t) { return core::cmath::exp(-t * t / 2); };
+    //       return calculus::integrate_gauss_kronrod(bell, 0.0, x, 4).value;
+    //   }, 0.0, 4.0);
+    template <std::size_t N, typename F, typename T>
+    constexpr std::array<T, N> constexpr_table(F f, T a, T b) {
+        static_assert(N >= 2, "constexpr_table<N>: N must be >= 2");
+        static_assert(std::is_floating_point_v<T>, "constexpr_table: T must be floating point");
+        std::array<T, N> out{};
+        const T h = (b - a) / static_cast<T>(N - 1);
+        for (std::size_t i = 0; i + 1 < N; ++i) out[i] = f(a + static_cast<T>(i) * h);
+        out[N - 1] = f(b);
+        return out;
+    }
+
+    // Linear interpolation in a table made by constexpr_table<N>(f, a, b);
+    // x outside [a, b] is clamped to the end values.
+    template <std::size_t N, typename T>
+    constexpr T interpolate(const std::array<T, N>& table, T a, T b, T x) {
+        static_assert(N >= 2, "interpolate<N>: N must be >= 2");
+        if (!(b > a)) MATHLIB_THROW(domain_error("interpolate(): need a < b"));
+        if (!(x > a)) return table[0];
+        if (!(x < b)) return table[N - 1];
+        const T s = (x - a) / (b - a) * static_cast<T>(N - 1);
+        std::size_t i = static_cast<std::size_t>(s);
+        if (i > N - 2) i = N - 2;
+        const T w = s - static_cast<T>(i);
+        return table[i] + w * (table[i + 1] - table[i]);
+    }
+
+} // namespace mathlib::core
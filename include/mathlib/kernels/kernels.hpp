@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+
+#include "mathlib/core/error.hpp"
+
+// Runtime-dispatched kernels for runtime-sized, contiguous data.
+//
+// Unlike the rest of the library these are compiled once, into the
+// MathLibKernels library that the MathLib target links. Every kernel is
+// built for each instruction set below. On first use the CPU is queried
+// (cpuid) and the widest supported variant is selected; calls then go
+// through a cached table of function pointers. So a baseline x86-64 binary
+// still gets AVX2/AVX-512 code on machines that have it.
+//
+// Setting MATHLIB_ISA=scalar|sse2|avx2|avx512 in the environment selects a
+// narrower path, for testing or for comparing paths. A request above what
+// the CPU supports falls back to the best supported set below it.
+//
+// Results of different paths agree to rounding, not bitwise: wider paths use
+// more partial sums and, with AVX2 and above, fused multiply-adds.
+namespace mathlib::kernels {
+
+    enum class isa {
+        scalar = 0, // reference path, auto-vectorization disabled
+        sse2,       // x86-64 baseline
+        avx2,       // AVX2 + FMA
+        avx512,     // AVX-512 F/VL/DQ/BW, 512-bit vectors
+    };
+
+    const char* to_string(isa i) noexcept;
+
+    // Widest instruction set both this CPU and this build support.
+    isa detected_isa() noexcept;
+
+    // The set calls are currently dispatched to.
+    isa active_isa() noexcept;
+
+    // Dispatch all kernels to `i` from now on. Returns false, and changes
+    // nothing, if `i` is not supported here.
+    bool set_isa(isa i) noexcept;
+
+    // sum_{i < n} x[i] * y[i]
+    float dot(const float* x, const float* y, std::size_t n) noexcept;
+    double dot(const double* x, const double* y, std::size_t n) noexcept;
+
+    // y[i] += alpha * x[i] for i < n
+    void axpy(float alpha, const float* x, float* y, std::size_t n) noexcept;
+    void axpy(double alpha, const double* x, double* y, std::size_t n) noexcept;
+
+    // sum_{i < n} x[i]
+    float sum(const float* x, std::size_t n) noexcept;
+    double sum(const double* x, std::size_t n) noexcept;
+
+    // out[r] = sum_{j < n} x[r * n + j] for r < rows. This is a batch of
+    // reductions, e.g. of function values sampled row by row.
+    void sum_rows(const float* x, std::size_t rows, std::size_t n, float* out) noexcept;
+    void sum_rows(const double* x, std::size_t rows, std::size_t n, double* out) noexcept;
+
+    // C = A * B, all row-major: A is m x k, B is k x n, C is m x n. C must
+    // not overlap A or B. The same layout as Matrix::a, so
+    //   gemm(A.a.data(), B.a.data(), C.a.data(), R, K, C)
+    // computes C = A * B for Matrix<R, K> A and Matrix<K, C> B.
+    void gemm(const float* A, const float* B, float* C, std::size_t m, std::size_t k, std::size_t n) noexcept;
+    void gemm(const double* A, const double* B, double* C, std::size_t m, std::size_t k, std::size_t n) noexcept;
+
+    // Solves `count` independent n x n systems A_s x = b_s by Gaussian
+    // elimination with partial pivoting (as linalg::solve). The matrices are
+    // stored back to back in A (row-major, n * n each) and the right-hand
+    // sides back to back in b. Each solution overwrites its b_s; A is
+    // scratch space afterwards. A system with a pivot <= pivot_eps is
+    // reported as singular_matrix in status[s] (if status is not null) and
+    // its b_s is unspecified. Returns the number of singular systems.
+    // Systems up to 8 x 8 are solved several at a time, one per vector lane.
+    std::size_t solve_batched(float* A, float* b, std::size_t count, std::size_t n,
+        float pivot_eps = 1e-6f, core::error_code* status = nullptr) noexcept;
+    std::size_t solve_batched(double* A, double* b, std::size_t count, std::size_t n,
+        double pivot_eps = 1e-12, core::error_code* status = nullptr) noexcept;
+
+} // namespace mathlib::kernels
@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/core/error.hpp"
+#include "mathlib/core/instrument.hpp"
+#include "mathlib/linalg/solve.hpp"
+
+namespace mathlib::linalg {
+
+    // LU factorization with partial pivoting: P A = L U.
+    // L (unit diagonal, not stored) and U share one matrix; perm[i] is the
+    // original row that ended up in row i.
+    template <std::size_t N, typename T>
+    struct LU {
+        Matrix<N, N, T> lu{};
+        std::array<std::size_t, N> perm{};
+    };
+
+    namespace detail {
+
+        // Factor in place; returns false if a pivot falls below pivot_eps.
+        template <std::size_t N, typename T>
+        bool lu_factor_inplace(LU<N, T>& f, T pivot_eps) {
+            auto& A = f.lu;
+            for (std::size_t i = 0; i < N; ++i) f.perm[i] = i;
+
+            for (std::size_t k = 0; k < N; ++k) {
+                std::size_t pivot = k;
+                T max_abs = std::abs(A(k, k));
+                for (std::size_t i = k + 1; i < N; ++i) {
+                    T v = std::abs(A(i, k));
+                    if (v > max_abs) {
+                        max_abs = v;
+                        pivot = i;
+                    }
+                }
+                if (max_abs <= pivot_eps) return false;
+
+                if (pivot != k) {
+                    for (std::size_t j = 0; j < N; ++j) std::swap(A(k, j), A(pivot, j));
+                    std::swap(f.perm[k], f.perm[pivot]);
+                }
+
+                for (std::size_t i = k + 1; i < N; ++i) {
+                    T factor = A(i, k) / A(k, k);
+                    A(i, k) = factor; // store L below the diagonal
+                    if (factor == T{}) continue;
+                    for (std::size_t j = k + 1; j < N; ++j) A(i, j) -= factor * A(k, j);
+                }
+            }
+            return true;
+        }
+
+    } // namespace detail
+
+    // Factor A once, then solve for as many right-hand sides as needed.
+    template <std::size_t N, typename T>
+    LU<N, T> lu_factor(const Matrix<N, N, T>& A, T pivot_eps = static_cast<T>(1e-12)) {
+        LU<N, T> f;
+        f.lu = A;
+        if (!detail::lu_factor_inplace(f, pivot_eps)) {
+            MATHLIB_THROW(core::domain_error("lu_factor(): matrix is singular or ill-conditioned (pivot ~ 0)"));
+        }
+        return f;
+    }
+
+    // Factor A into caller-provided storage, e.g. a heap-allocated LU when N is
+    // too large for the stack. A is only read, so it may be a mapped_matrix view.
+    template <std::size_t N, typename T>
+    void lu_factor_into(const Matrix<N, N, T>& A, LU<N, T>& f, T pivot_eps = static_cast<T>(1e-12)) {
+        f.lu = A;
+        if (!detail::lu_factor_inplace(f, pivot_eps)) {
+            MATHLIB_THROW(core::domain_error("lu_factor_into(): matrix is singular or ill-conditioned (pivot ~ 0)"));
+        }
+    }
+
+    // Same, recording the pivot growth factor max|U| / max|A| in stats.
+    template <std::size_t N, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    LU<N, T> lu_factor(const Matrix<N, N, T>& A, T pivot_eps, Stats& stats) {
+        auto timer = stats.scoped_timer();
+        LU<N, T> f = lu_factor(A, pivot_eps);
+        if constexpr (Stats::enabled) {
+            const T a_max = detail::max_abs_entry(A, false);
+            if (a_max > T{}) stats.note_pivot_growth(static_cast<double>(detail::max_abs_entry(f.lu, true) / a_max));
+        }
+        stats.set_converged(true);
+        return f;
+    }
+
+    // Solve A x = b given lu_factor(A): O(N^2).
+    template <std::size_t N, typename T>
+    Vector<N, T> lu_solve(const LU<N, T>& f, const Vector<N, T>& b) {
+        Vector<N, T> x;
+        // Forward substitution with unit-lower L (applying P on the fly)
+        for (std::size_t i = 0; i < N; ++i) {
+            T sum = b[f.perm[i]];
+            for (std::size_t j = 0; j < i; ++j) sum -= f.lu(i, j) * x[j];
+            x[i] = sum;
+        }
+        // Back substitution with U
+        for (std::size_t i = N; i-- > 0;) {
+            T sum = x[i];
+            for (std::size_t j = i + 1; j < N; ++j) sum -= f.lu(i, j) * x[j];
+            x[i] = sum / f.lu(i, i);
+        }
+        return x;
+    }
+
+} // namespace mathlib::linalg
@@ -0,0 +1,181 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/core/mapped_file.hpp"
+#include "mathlib/linalg/lu.hpp"
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/vector.hpp"
+
+namespace mathlib::linalg {
+
+    // Binary matrix file (little-endian): a 64-byte header followed by the
+    // elements at data_offset (64-byte aligned), densely packed in the stated
+    // layout. Vectors are stored as N x 1 matrices.
+    enum class matrix_layout : std::uint32_t { row_major = 0, column_major = 1 };
+
+    namespace detail {
+
+        inline constexpr char matrix_magic[8] = { 'M', 'L', 'M', 'A', 'T', 'R', 'I', 'X' };
+        inline constexpr std::uint32_t matrix_version = 1;
+        inline constexpr std::uint64_t matrix_data_offset = 64;
+
+        struct MatrixFileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t dtype;
+            std::uint64_t rows;
+            std::uint64_t cols;
+            std::uint32_t layout;
+            std::uint32_t reserved0;
+            std::uint64_t data_offset;
+            std::uint8_t reserved1[16];
+        };
+        static_assert(sizeof(MatrixFileHeader) == matrix_data_offset);
+
+        // kind in the high byte (0 float, 1 signed, 2 unsigned), size in the low byte
+        template <typename T>
+        constexpr std::uint32_t matrix_dtype() {
+            static_assert(std::is_arithmetic_v<T>);
+            const std::uint32_t kind = std::is_floating_point_v<T> ? 0u : (std::is_signed_v<T> ? 1u : 2u);
+            return (kind << 8) | static_cast<std::uint32_t>(sizeof(T));
+        }
+
+        template <typename T>
+        void write_matrix_file(const std::string& path, std::size_t rows, std::size_t cols, const T* data,
+            matrix_layout layout) {
+            MatrixFileHeader h{};
+            std::memcpy(h.magic, matrix_magic, sizeof(h.magic));
+            h.version = matrix_version;
+            h.dtype = matrix_dtype<T>();
+            h.rows = rows;
+            h.cols = cols;
+            h.layout = static_cast<std::uint32_t>(layout);
+            h.data_offset = matrix_data_offset;
+
+            std::FILE* f = std::fopen(path.c_str(), "wb");
+            if (!f) MATHLIB_THROW(core::io_error("save_matrix(): cannot create " + path));
+            const std::size_t n = rows * cols;
+            const bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1 && std::fwrite(data, sizeof(T), n, f) == n;
+            if (std::fclose(f) != 0 || !ok) MATHLIB_THROW(core::io_error("save_matrix(): cannot write " + path));
+        }
+
+        // Validates the header and returns the element pointer.
+        template <typename T>
+        const std::byte* map_matrix_data(const core::mapped_file& file, std::size_t rows, std::size_t cols,
+            const std::string& path) {
+            if (file.size() < sizeof(MatrixFileHeader)) MATHLIB_THROW(core::io_error("mapped_matrix(): " + path + " is too small"));
+            MatrixFileHeader h;
+            std::memcpy(&h, file.data(), sizeof(h));
+            if (std::memcmp(h.magic, matrix_magic, sizeof(h.magic)) != 0 || h.version != matrix_version) {
+                MATHLIB_THROW(core::io_error("mapped_matrix(): " + path + " is not a matrix file"));
+            }
+            if (h.dtype != matrix_dtype<T>()) MATHLIB_THROW(core::dimension_error("mapped_matrix(): dtype mismatch"));
+            if (h.rows != rows || h.cols != cols) MATHLIB_THROW(core::dimension_error("mapped_matrix(): shape mismatch"));
+            if (h.layout != static_cast<std::uint32_t>(matrix_layout::row_major) && rows > 1 && cols > 1) {
+                // a column-major R x C file is the row-major image of its C x R transpose
+                MATHLIB_THROW(core::dimension_error("mapped_matrix(): file is column-major; map its transpose instead"));
+            }
+            if (h.data_offset % alignof(T) != 0 || file.size() < h.data_offset + rows * cols * sizeof(T)) {
+                MATHLIB_THROW(core::io_error("mapped_matrix(): " + path + " is truncated or misaligned"));
+            }
+            return file.data() + h.data_offset;
+        }
+
+    } // namespace detail
+
+    template <std::size_t R, std::size_t C, typename T>
+    void save_matrix(const std::string& path, const Matrix<R, C, T>& A) {
+        detail::write_matrix_file(path, R, C, A.a.data(), matrix_layout::row_major);
+    }
+
+    template <std::size_t N, typename T>
+    void save_vector(const std::string& path, const Vector<N, T>& x) {
+        detail::write_matrix_file(path, N, 1, x.v.data(), matrix_layout::row_major);
+    }
+
+    // Raw writer for data that is not held in a Matrix (e.g. produced in pieces).
+    template <typename T>
+    void save_matrix(const std::string& path, std::size_t rows, std::size_t cols, const T* data,
+        matrix_layout layout = matrix_layout::row_major) {
+        detail::write_matrix_file(path, rows, cols, data, layout);
+    }
+
+    // Matrix<R,C,T> backed by a memory-mapped file. view() is an ordinary
+    // const Matrix&; pages are faulted in on first touch instead of parsed up
+    // front. Routines taking const Matrix& read the mapping in place: mul,
+    // lu_factor_into (into caller storage) and element access. solve() takes
+    // A by value and transpose / operator* return a Matrix, so those copy a
+    // full R x C matrix onto the stack; use them only where that is
+    // acceptable. For large products, kernels::gemm(view().a.data(), ...)
+    // writes into caller storage instead.
+    template <std::size_t R, std::size_t C, typename T = double>
+    class mapped_matrix {
+        static_assert(sizeof(Matrix<R, C, T>) == R * C * sizeof(T) && std::is_trivially_copyable_v<Matrix<R, C, T>>,
+            "Matrix must be layout-compatible with a dense array");
+
+    public:
+        using mode = core::mapped_file::mode;
+        using access = core::mapped_file::access;
+
+        explicit mapped_matrix(const std::string& path, mode m = mode::read_only)
+            : file_(path, m), data_(detail::map_matrix_data<T>(file_, R, C, path)) {}
+
+        const Matrix<R, C, T>& view() const {
+            return *std::launder(reinterpret_cast<const Matrix<R, C, T>*>(data_));
+        }
+        operator const Matrix<R, C, T>&() const { return view(); }
+
+        // Private writable copy of the touched pages (copy_on_write mode only);
+        // the file itself is never modified.
+        Matrix<R, C, T>& mutable_view() {
+            std::byte* base = file_.mutable_data();
+            return *std::launder(reinterpret_cast<Matrix<R, C, T>*>(base + (data_ - file_.data())));
+        }
+
+        const T& operator()(std::size_t r, std::size_t c) const { return view()(r, c); }
+
+        void advise(access a) const noexcept { file_.advise(a); }
+
+    private:
+        core::mapped_file file_;
+        const std::byte* data_;
+    };
+
+    template <std::size_t N, typename T = double>
+    class mapped_vector {
+        static_assert(sizeof(Vector<N, T>) == N * sizeof(T) && std::is_trivially_copyable_v<Vector<N, T>>,
+            "Vector must be layout-compatible with a dense array");
+
+    public:
+        using mode = core::mapped_file::mode;
+        using access = core::mapped_file::access;
+
+        explicit mapped_vector(const std::string& path, mode m = mode::read_only)
+            : file_(path, m), data_(detail::map_matrix_data<T>(file_, N, 1, path)) {}
+
+        const Vector<N, T>& view() const {
+            return *std::launder(reinterpret_cast<const Vector<N, T>*>(data_));
+        }
+        operator const Vector<N, T>&() const { return view(); }
+
+        Vector<N, T>& mutable_view() {
+            std::byte* base = file_.mutable_data();
+            return *std::launder(reinterpret_cast<Vector<N, T>*>(base + (data_ - file_.data())));
+        }
+
+        const T& operator[](std::size_t i) const { return view()[i]; }
+
+        void advise(access a) const noexcept { file_.advise(a); }
+
+    private:
+        core::mapped_file file_;
+        const std::byte* data_;
+    };
+
+} // namespace mathlib::linalg
@@ -5,6 +5,9 @@
 #include <stdexcept>
 #include <type_traits>
 
+#include "mathlib/core/error.hpp"
+#include "mathlib/core/reduce.hpp"
+
 namespace mathlib::linalg {
 
     template <std::size_t R, std::size_t C, typename T = double>
@@ -20,7 +23,7 @@ namespace mathlib::linalg {
         // Allow: Matrix<2,3>{ 1,2,3,4,5,6 }
         constexpr Matrix(std::initializer_list<T> init) {
             if (init.size() != R * C) {
-                throw std::invalid_argument("Matrix initializer_list size mismatch");
+                MATHLIB_THROW(std::invalid_argument("Matrix initializer_list size mismatch"));
             }
             std::size_t i = 0;
             for (auto& x : init) a[i++] = x;
@@ -51,15 +54,51 @@ namespace mathlib::linalg {
         return out;
     }
 
-    // Matrix * Matrix
+    namespace detail {
+
+        // out[c] = sum_{k0 <= k < k0 + n} a[k] * B(k, c) for all C columns of B.
+        // The output row is the set of accumulators (C independent chains that
+        // vectorize across c); k ranges longer than pairwise_sum::block are
+        // split in half and the partial rows added, as in core::reduce_sum.
+        template <std::size_t C, typename T>
+        constexpr void row_times_matrix(const T* a, const T* B, std::size_t k0, std::size_t n, T* out) {
+            if (n <= core::pairwise_sum::block) {
+                std::array<T, C> acc{}; // local, so it cannot alias B
+                for (std::size_t k = k0; k < k0 + n; ++k) {
+                    const T s = a[k];
+                    const T* b = B + k * C;
+                    for (std::size_t c = 0; c < C; ++c) acc[c] += s * b[c];
+                }
+                for (std::size_t c = 0; c < C; ++c) out[c] = acc[c];
+                return;
+            }
+            const std::size_t half = n / 2;
+            std::array<T, C> rest{};
+            row_times_matrix<C>(a, B, k0, half, out);
+            row_times_matrix<C>(a, B, k0 + half, n - half, rest.data());
+            for (std::size_t c = 0; c < C; ++c) out[c] += rest[c];
+        }
+
+    } // namespace detail
+
+    // Matrix * Matrix. Short inner dimensions keep the plain dot-product loop
+    // (measured faster below K = 32); longer ones go row by row through
+    // detail::row_times_matrix.
     template <std::size_t R, std::size_t K, std::size_t C, typename T>
     constexpr Matrix<R, C, T> operator*(const Matrix<R, K, T>& A, const Matrix<K, C, T>& B) {
         Matrix<R, C, T> out;
-        for (std::size_t r = 0; r < R; ++r) {
-            for (std::size_t c = 0; c < C; ++c) {
-                T sum{};
-                for (std::size_t k = 0; k < K; ++k) sum += A(r, k) * B(k, c);
-                out(r, c) = sum;
+        if constexpr (K < 32) {
+            for (std::size_t r = 0; r < R; ++r) {
+                for (std::size_t c = 0; c < C; ++c) {
+                    T sum{};
+                    for (std::size_t k = 0; k < K; ++k) sum += A(r, k) * B(k, c);
+                    out(r, c) = sum;
+                }
+            }
+        }
+        else {
+            for (std::size_t r = 0; r < R; ++r) {
+                detail::row_times_matrix<C>(A.a.data() + r * K, B.a.data(), 0, K, out.a.data() + r * C);
             }
         }
         return out;
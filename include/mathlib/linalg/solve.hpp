@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <cstddef>
 #include <stdexcept>
 #include <cmath>
@@ -6,78 +7,137 @@
 #include "mathlib/linalg/matrix.hpp"
 #include "mathlib/linalg/vector.hpp"
 #include "mathlib/core/almost_equal.hpp"
+#include "mathlib/core/cmath.hpp"
 #include "mathlib/core/error.hpp"
+#include "mathlib/core/reduce.hpp"
+#include "mathlib/core/expected.hpp"
+#include "mathlib/core/instrument.hpp"
 
 namespace mathlib::linalg {
 
-    // Solve A x = b using Gaussian elimination with partial pivoting.
-    // Works for fixed-size square matrices Matrix<N,N,T> and Vector<N,T>.
-    template <std::size_t N, typename T>
-    Vector<N, T> solve(Matrix<N, N, T> A, Vector<N, T> b,
-        T pivot_eps = static_cast<T>(1e-12)) {
-        static_assert(N > 0, "solve<N>: N must be > 0");
+    namespace detail {
 
-        // Forward elimination
-        for (std::size_t k = 0; k < N; ++k) {
-            // Find pivot row p with max |A(p,k)| for p>=k
-            std::size_t pivot = k;
-            T max_abs = std::abs(A(k, k));
-            for (std::size_t i = k + 1; i < N; ++i) {
-                T v = std::abs(A(i, k));
-                if (v > max_abs) {
-                    max_abs = v;
-                    pivot = i;
-                }
+        // max |A(i,j)| over the upper triangle (upper_only) or the whole matrix
+        template <std::size_t N, typename T>
+        constexpr T max_abs_entry(const Matrix<N, N, T>& A, bool upper_only) {
+            T m{};
+            for (std::size_t i = 0; i < N; ++i) {
+                for (std::size_t j = upper_only ? i : 0; j < N; ++j) m = std::max(m, core::cmath::abs(A(i, j)));
             }
+            return m;
+        }
 
-            // Check near-singular pivot
-            if (max_abs <= pivot_eps) {
-                throw core::domain_error("solve(): matrix is singular or ill-conditioned (pivot ~ 0)");
-            }
+        // Gaussian elimination on A and b in place, writing the solution to x.
+        // Returns singular_matrix instead of throwing on a pivot <= pivot_eps.
+        template <std::size_t N, typename T, typename Stats>
+        constexpr core::error_code gauss_solve(Matrix<N, N, T>& A, Vector<N, T>& b, T pivot_eps, Stats& stats, Vector<N, T>& x) {
+            auto timer = stats.scoped_timer();
+            [[maybe_unused]] T a_max{};
+            if constexpr (Stats::enabled) a_max = detail::max_abs_entry(A, false);
 
-            // Swap pivot row into place
-            if (pivot != k) {
-                for (std::size_t j = k; j < N; ++j) {
-                    std::swap(A(k, j), A(pivot, j));
+            // Forward elimination
+            for (std::size_t k = 0; k < N; ++k) {
+                // Find pivot row p with max |A(p,k)| for p>=k
+                std::size_t pivot = k;
+                T max_abs = core::cmath::abs(A(k, k));
+                for (std::size_t i = k + 1; i < N; ++i) {
+                    T v = core::cmath::abs(A(i, k));
+                    if (v > max_abs) {
+                        max_abs = v;
+                        pivot = i;
+                    }
                 }
-                std::swap(b[k], b[pivot]);
+
+                // Check near-singular pivot
+                if (max_abs <= pivot_eps) return core::error_code::singular_matrix;
+
+                // Swap pivot row into place
+                if (pivot != k) {
+                    for (std::size_t j = k; j < N; ++j) {
+                        std::swap(A(k, j), A(pivot, j));
+                    }
+                    std::swap(b[k], b[pivot]);
+                }
+
+                // Eliminate below pivot
+                for (std::size_t i = k + 1; i < N; ++i) {
+                    T factor = A(i, k) / A(k, k);
+                    A(i, k) = T{}; // exactly zero out
+                    for (std::size_t j = k + 1; j < N; ++j) {
+                        A(i, j) -= factor * A(k, j);
+                    }
+                    b[i] -= factor * b[k];
+                }
+                stats.add_iteration();
+                if constexpr (Stats::tracing) {
+                    stats.event({ "solve", "pivot", k, static_cast<double>(pivot), static_cast<double>(max_abs), 0.0 });
+                }
+            }
+            if constexpr (Stats::enabled) {
+                if (a_max > T{}) stats.note_pivot_growth(static_cast<double>(detail::max_abs_entry(A, true) / a_max));
             }
 
-            // Eliminate below pivot
-            for (std::size_t i = k + 1; i < N; ++i) {
-                T factor = A(i, k) / A(k, k);
-                A(i, k) = T{}; // exactly zero out
-                for (std::size_t j = k + 1; j < N; ++j) {
-                    A(i, j) -= factor * A(k, j);
+            // Back substitution
+            for (std::size_t i = N; i-- > 0;) {
+                T sum = b[i];
+                for (std::size_t j = i + 1; j < N; ++j) {
+                    sum -= A(i, j) * x[j];
                 }
-                b[i] -= factor * b[k];
+                if (core::cmath::abs(A(i, i)) <= pivot_eps) return core::error_code::singular_matrix;
+                x[i] = sum / A(i, i);
             }
+            stats.set_converged(true);
+            return core::error_code::ok;
         }
 
-        // Back substitution
+    } // namespace detail
+
+    // Solve A x = b using Gaussian elimination with partial pivoting.
+    // Works for fixed-size square matrices Matrix<N,N,T> and Vector<N,T>.
+    // Stats records one iteration per eliminated column and the pivot growth
+    // factor max|U| / max|A| (large values flag an unstable elimination).
+    template <std::size_t N, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    constexpr Vector<N, T> solve(Matrix<N, N, T> A, Vector<N, T> b, T pivot_eps, Stats& stats) {
+        static_assert(N > 0, "solve<N>: N must be > 0");
         Vector<N, T> x;
-        for (std::size_t i = N; i-- > 0;) {
-            T sum = b[i];
-            for (std::size_t j = i + 1; j < N; ++j) {
-                sum -= A(i, j) * x[j];
-            }
-            if (std::abs(A(i, i)) <= pivot_eps) {
-                throw core::domain_error("solve(): matrix is singular or ill-conditioned (diag ~ 0)");
-            }
-            x[i] = sum / A(i, i);
+        if (detail::gauss_solve(A, b, pivot_eps, stats, x) != core::error_code::ok) {
+            MATHLIB_THROW(core::domain_error("solve(): matrix is singular or ill-conditioned (pivot ~ 0)"));
         }
         return x;
     }
 
+    template <std::size_t N, typename T>
+    constexpr Vector<N, T> solve(Matrix<N, N, T> A, Vector<N, T> b,
+        T pivot_eps = static_cast<T>(1e-12)) {
+        core::null_stats stats;
+        return solve(A, b, pivot_eps, stats);
+    }
+
+    // Non-throwing solve: a pivot <= pivot_eps gives singular_matrix. With
+    // stats, the columns eliminated before the failure are still recorded.
+    template <std::size_t N, typename T, typename Stats>
+        requires core::stats_policy<Stats>
+    core::expected<Vector<N, T>, core::error_code> try_solve(Matrix<N, N, T> A, Vector<N, T> b, T pivot_eps,
+        Stats& stats) noexcept {
+        static_assert(N > 0, "try_solve<N>: N must be > 0");
+        Vector<N, T> x;
+        if (auto c = detail::gauss_solve(A, b, pivot_eps, stats, x); c != core::error_code::ok) return core::fail(c);
+        return x;
+    }
+
+    template <std::size_t N, typename T>
+    core::expected<Vector<N, T>, core::error_code> try_solve(Matrix<N, N, T> A, Vector<N, T> b,
+        T pivot_eps = static_cast<T>(1e-12)) noexcept {
+        core::null_stats stats;
+        return try_solve(A, b, pivot_eps, stats);
+    }
+
     // Helper: compute A*x (useful for tests and examples)
     template <std::size_t N, typename T>
-    Vector<N, T> mul(const Matrix<N, N, T>& A, const Vector<N, T>& x) {
+    constexpr Vector<N, T> mul(const Matrix<N, N, T>& A, const Vector<N, T>& x) {
         Vector<N, T> y;
-        for (std::size_t r = 0; r < N; ++r) {
-            T sum{};
-            for (std::size_t c = 0; c < N; ++c) sum += A(r, c) * x[c];
-            y[r] = sum;
-        }
+        for (std::size_t r = 0; r < N; ++r) y[r] = core::reduce_dot(A.a.data() + r * N, x.v.data(), N);
         return y;
     }
 
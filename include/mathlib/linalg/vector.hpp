@@ -6,6 +6,9 @@
 #include <stdexcept>
 #include <type_traits>
 
+#include "mathlib/core/error.hpp"
+#include "mathlib/core/reduce.hpp"
+
 namespace mathlib::linalg {
 
     template <std::size_t N, typename T = double>
@@ -20,7 +23,7 @@ namespace mathlib::linalg {
         // Allow: Vector<3>{1,2,3}
         constexpr Vector(std::initializer_list<T> init) {
             if (init.size() != N) {
-                throw std::invalid_argument("Vector initializer_list size mismatch");
+                MATHLIB_THROW(std::invalid_argument("Vector initializer_list size mismatch"));
             }
             std::size_t i = 0;
             for (auto& x : init) v[i++] = x;
@@ -51,17 +54,15 @@ namespace mathlib::linalg {
         friend constexpr Vector operator*(T s, const Vector& a) { return a * s; }
 
         friend constexpr Vector operator/(const Vector& a, T s) {
-            if (s == T{}) throw std::invalid_argument("Vector division by zero scalar");
+            if (s == T{}) MATHLIB_THROW(std::invalid_argument("Vector division by zero scalar"));
             Vector out;
             for (std::size_t i = 0; i < N; ++i) out[i] = a[i] / s;
             return out;
         }
 
-        // Dot product
+        // Dot product (pairwise summation, see core/reduce.hpp)
         friend constexpr T dot(const Vector& a, const Vector& b) {
-            T sum{};
-            for (std::size_t i = 0; i < N; ++i) sum += a[i] * b[i];
-            return sum;
+            return core::reduce_dot(a.v.data(), b.v.data(), N);
         }
 
         // Squared length, length
@@ -74,7 +75,7 @@ namespace mathlib::linalg {
 
         Vector normalized(T eps = static_cast<T>(1e-12)) const {
             T n = norm();
-            if (n <= eps) throw std::domain_error("Cannot normalize near-zero vector");
+            if (n <= eps) MATHLIB_THROW(std::domain_error("Cannot normalize near-zero vector"));
             return (*this) / n;
         }
     };
@@ -0,0 +1,204 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/ode/dopri5.hpp"
+#include "mathlib/ode/observers.hpp"
+
+namespace mathlib::ode {
+
+    // Continuous extension of one Dormand-Prince step (Hairer's contd5): a
+    // quartic in theta = (t - t0) / h built from the stages the step already
+    // computed, so evaluating it costs no calls of f.
+    template <typename State, typename T>
+    struct DenseStep {
+        T t0{};
+        T h{};
+        State r[5]{};
+
+        State operator()(T t) const {
+            const T theta = (t - t0) / h;
+            const T theta1 = static_cast<T>(1) - theta;
+            return r[0] + theta * (r[1] + theta1 * (r[2] + theta * (r[3] + theta1 * r[4])));
+        }
+
+        T t1() const { return t0 + h; }
+    };
+
+    // Build the interpolant of the step the stepper just accepted.
+    template <typename F, typename State, typename T>
+    DenseStep<State, T> dense_step(const Dopri5<F, State, T>& s) {
+        const T h = s.h_last();
+        const State& k1 = s.k(0);
+        const State& k7 = s.k(6);
+        const State ydiff = s.y() - s.y_prev();
+        const State bspl = h * k1 - ydiff;
+
+        DenseStep<State, T> d;
+        d.t0 = s.t_prev();
+        d.h = h;
+        d.r[0] = s.y_prev();
+        d.r[1] = ydiff;
+        d.r[2] = bspl;
+        d.r[3] = ydiff - h * k7 - bspl;
+        d.r[4] = h * (T(-12715105075.0) / T(11282082432.0)) * k1
+            + h * (T(87487479700.0) / T(32700410799.0)) * s.k(2)
+            + h * (T(-10690763975.0) / T(1880347072.0)) * s.k(3)
+            + h * (T(701980252875.0) / T(199316789632.0)) * s.k(4)
+            + h * (T(-1453857185.0) / T(822651844.0)) * s.k(5)
+            + h * (T(69997945.0) / T(29380423.0)) * k7;
+        return d;
+    }
+
+    // Piecewise interpolant over a whole adaptive solve; query in O(log steps).
+    template <typename State, typename T>
+    class DenseSolution {
+    public:
+        explicit DenseSolution(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+            : steps_(mr) {}
+
+        void push_back(const DenseStep<State, T>& s) {
+            steps_.push_back(s);
+        }
+
+        bool empty() const { return steps_.empty(); }
+        std::size_t size() const { return steps_.size(); }
+        const DenseStep<State, T>& step(std::size_t i) const { return steps_[i]; }
+
+        T t_begin() const { return steps_.front().t0; }
+        T t_end() const { return steps_.back().t1(); }
+
+        State operator()(T t) const {
+            if (steps_.empty()) MATHLIB_THROW(mathlib::core::domain_error("DenseSolution: empty solution"));
+            if (t < t_begin() || t > t_end()) MATHLIB_THROW(mathlib::core::domain_error("DenseSolution: t outside [t_begin, t_end]"));
+            auto it = std::upper_bound(steps_.begin(), steps_.end(), t,
+                [](T v, const DenseStep<State, T>& s) { return v < s.t0; });
+            if (it != steps_.begin()) --it;
+            return (*it)(t);
+        }
+
+    private:
+        std::pmr::vector<DenseStep<State, T>> steps_;
+    };
+
+    // Integrate with Dormand-Prince and keep the continuous solution; the steps
+    // are allocated from mr.
+    template <typename F, typename State, typename T>
+    DenseSolution<State, T> solve_rk45_dense(F f, T t0, State y0, T t1, const Rk45Options<T>& opt,
+        std::pmr::memory_resource* mr, Rk45Stats* stats = nullptr) {
+        Dopri5<F, State, T> stepper(std::move(f), t0, std::move(y0), t1, opt);
+        DenseSolution<State, T> sol(mr);
+        while (!stepper.done()) {
+            stepper.step();
+            sol.push_back(dense_step(stepper));
+        }
+        if (stats) *stats = stepper.stats();
+        return sol;
+    }
+
+    template <typename F, typename State, typename T>
+    DenseSolution<State, T> solve_rk45_dense(F f, T t0, State y0, T t1,
+        const Rk45Options<T>& opt = {}, Rk45Stats* stats = nullptr) {
+        return solve_rk45_dense(std::move(f), t0, std::move(y0), t1, opt, std::pmr::get_default_resource(), stats);
+    }
+
+    // Report the solution at the given ascending times from the interpolant;
+    // the step size is chosen by accuracy alone, never by the output grid.
+    template <typename F, typename State, typename T, typename Obs>
+        requires observer<Obs, State, T>
+    std::pair<T, State> solve_rk45_at(F f, T t0, State y0, const std::vector<T>& times,
+        const Rk45Options<T>& opt, Obs&& obs, Rk45Stats* stats = nullptr) {
+        for (std::size_t i = 0; i < times.size(); ++i) {
+            if (times[i] < t0 || (i > 0 && times[i] < times[i - 1])) {
+                MATHLIB_THROW(mathlib::core::domain_error("solve_rk45_at(): times must be ascending and >= t0"));
+            }
+        }
+        const T t1 = times.empty() ? t0 : times.back();
+        Dopri5<F, State, T> stepper(std::move(f), t0, std::move(y0), t1, opt);
+
+        std::size_t next = 0;
+        bool go = true;
+        while (go && next < times.size() && times[next] == t0) go = detail::notify(obs, times[next++], stepper.y());
+        while (go && !stepper.done()) {
+            stepper.step();
+            const auto d = dense_step(stepper);
+            while (go && next < times.size() && times[next] <= stepper.t()) {
+                const T tq = times[next++];
+                go = detail::notify(obs, tq, tq == stepper.t() ? stepper.y() : d(tq));
+            }
+        }
+        if (stats) *stats = stepper.stats();
+        return { stepper.t(), stepper.y() };
+    }
+
+    namespace detail {
+
+        // Crossing of g on [a, b] given g(a), g(b) of opposite signs: bisects
+        // until no double lies strictly between a and b and returns the end on
+        // g(b)'s side. Stops early only on an exact zero, never on |g| being
+        // small, so the result does not depend on the units of g.
+        template <typename G, typename T>
+        T bisect_event(G& g, T a, T b, T ga) {
+            const bool neg_a = ga < T{};
+            for (;;) {
+                const T m = a + (b - a) / static_cast<T>(2);
+                if (!(m > a && m < b)) return b;
+                const T gm = g(m);
+                if (gm == T{}) return m;
+                if ((gm < T{}) == neg_a) a = m;
+                else b = m;
+            }
+        }
+
+    } // namespace detail
+
+    template <typename State, typename T>
+    struct EventResult {
+        bool triggered = false;
+        T t{};
+        State y{};
+    };
+
+    // Integrate until g(t, y) changes sign (or t1 is reached). The crossing is
+    // located on the step's interpolant, so it never forces small steps.
+    template <typename F, typename G, typename State, typename T>
+    EventResult<State, T> solve_rk45_until(F f, G g, T t0, State y0, T t1,
+        const Rk45Options<T>& opt = {}, Rk45Stats* stats = nullptr) {
+        Dopri5<F, State, T> stepper(std::move(f), t0, std::move(y0), t1, opt);
+        EventResult<State, T> ev;
+        T g_prev = g(stepper.t(), stepper.y());
+
+        while (!stepper.done()) {
+            stepper.step();
+            const T g_now = g(stepper.t(), stepper.y());
+            if (g_now == T{} || (g_prev < T{}) != (g_now < T{})) {
+                const auto d = dense_step(stepper);
+                auto gi = [&](T t) { return g(t, d(t)); };
+                // bracket on the interpolant itself; if rounding leaves no sign
+                // change on it, the crossing is at one of the ends
+                const T ga = gi(d.t0);
+                const T gb = gi(stepper.t());
+                ev.triggered = true;
+                if (g_now == T{} || gb == T{}) ev.t = stepper.t();
+                else if (ga == T{}) ev.t = d.t0;
+                else if ((ga < T{}) == (gb < T{})) ev.t = stepper.t();
+                else ev.t = detail::bisect_event(gi, d.t0, stepper.t(), ga);
+                ev.y = (ev.t == stepper.t()) ? stepper.y() : d(ev.t);
+                if (stats) *stats = stepper.stats();
+                return ev;
+            }
+            g_prev = g_now;
+        }
+        ev.t = stepper.t();
+        ev.y = stepper.y();
+        if (stats) *stats = stepper.stats();
+        return ev;
+    }
+
+} // namespace mathlib::ode
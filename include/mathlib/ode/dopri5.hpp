@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/ode/state.hpp"
+
+namespace mathlib::ode {
+
+    // How the scaled components err_i / (atol + rtol * |y_i|) of the embedded
+    // error estimate are combined; a step is accepted when the result is <= 1.
+    enum class rk45_norm {
+        rms, // sqrt(mean(r_i^2)), as Hairer & Wanner
+        max, // max |r_i|: every component within tolerance
+    };
+
+    template <typename T>
+    struct Rk45Options {
+        T rtol = static_cast<T>(1e-6);
+        T atol = static_cast<T>(1e-9);
+        T h0 = T{};                                         // initial step (0 = automatic)
+        T h_min = static_cast<T>(1e-12);
+        T h_max = std::numeric_limits<T>::infinity();
+        T safety = static_cast<T>(0.9);
+        T min_factor = static_cast<T>(0.2);                 // bounds on h_new / h
+        T max_factor = static_cast<T>(10);
+        T beta = static_cast<T>(0.04);                      // PI controller weight (0 = plain I control)
+        std::size_t max_steps = 1000000;
+        rk45_norm norm = rk45_norm::rms;
+    };
+
+    struct Rk45Stats {
+        std::size_t accepted = 0;
+        std::size_t rejected = 0;
+        std::size_t f_evals = 0;
+    };
+
+    // Dormand-Prince 5(4) stepper with FSAL (the last stage of an accepted step
+    // is the next step's first), a PI (Gustafsson) step-size controller and an
+    // RMS (or max, see Rk45Options::norm) error norm over per-component
+    // atol + rtol * |y|.
+    // Accepted steps cost six evaluations of f; rejected steps reuse k1.
+    template <typename F, typename State, typename T>
+    class Dopri5 {
+    public:
+        using traits = state_traits<State>;
+
+        Dopri5(F f, T t0, State y0, T t_end, const Rk45Options<T>& opt = {})
+            : f_(std::move(f)), opt_(opt), t_(t0), t_end_(t_end), y_(std::move(y0)) {
+            if (const char* msg = check_options(opt_, t_, t_end_)) MATHLIB_THROW(mathlib::core::domain_error(msg));
+
+            k1_ = eval(t_, y_);
+            h_ = (opt_.h0 > T{}) ? opt_.h0 : initial_step();
+            h_ = std::clamp(h_, opt_.h_min, opt_.h_max);
+        }
+
+        bool done() const { return t_ >= t_end_; }
+
+        T t() const { return t_; }
+        const State& y() const { return y_; }
+        T step_size() const { return h_; }
+        const Rk45Stats& stats() const { return stats_; }
+        // Scaled error norm of the last accepted step (<= 1)
+        T error() const { return err_last_; }
+
+        // Data of the last accepted step [t_prev, t] (stages for dense output)
+        T t_prev() const { return t_prev_; }
+        const State& y_prev() const { return y_prev_; }
+        T h_last() const { return t_ - t_prev_; }
+        const State& k(std::size_t i) const { return stage_[i]; }
+
+        // Reason the constructor would reject these arguments, or nullptr.
+        static const char* check_options(const Rk45Options<T>& opt, T t0, T t_end) noexcept {
+            if (opt.rtol < T{} || opt.atol < T{} || (opt.rtol == T{} && opt.atol == T{})) {
+                return "solve_rk45(): need rtol >= 0, atol >= 0, not both zero";
+            }
+            if (opt.h_min <= T{} || opt.h_max < opt.h_min) return "solve_rk45(): need 0 < h_min <= h_max";
+            if (t_end < t0) return "solve_rk45(): t1 must be >= t0";
+            return nullptr;
+        }
+
+        // Advance by one accepted step (retrying rejected attempts internally).
+        void step() {
+            switch (try_step()) {
+            case mathlib::core::error_code::ok: return;
+            case mathlib::core::error_code::too_many_steps:
+                MATHLIB_THROW(mathlib::core::domain_error("solve_rk45(): too many steps"));
+            default:
+                MATHLIB_THROW(mathlib::core::domain_error("solve_rk45(): step underflow (h < h_min)"));
+            }
+        }
+
+        // As step(), but reports failure as a status; the stepper is left at the
+        // last accepted point so stats() and y() stay meaningful.
+        mathlib::core::error_code try_step() {
+            if (done()) return mathlib::core::error_code::ok;
+            bool rejected = false;
+
+            for (;;) {
+                if (stats_.accepted + stats_.rejected >= opt_.max_steps) {
+                    return mathlib::core::error_code::too_many_steps;
+                }
+                if (h_ < opt_.h_min) return mathlib::core::error_code::step_underflow;
+
+                const bool last = t_ + h_ >= t_end_;
+                const T h = last ? t_end_ - t_ : h_;
+                const State& k1 = k1_;
+
+                State k2 = eval(t_ + h * (T(1) / 5), y_ + h * (T(1) / 5) * k1);
+                State k3 = eval(t_ + h * (T(3) / 10), y_ + h * (T(3) / 40) * k1 + h * (T(9) / 40) * k2);
+                State k4 = eval(t_ + h * (T(4) / 5), y_ + h * (T(44) / 45) * k1 + h * (T(-56) / 15) * k2 + h * (T(32) / 9) * k3);
+                State k5 = eval(t_ + h * (T(8) / 9), y_ + h * (T(19372) / 6561) * k1 + h * (T(-25360) / 2187) * k2 + h * (T(64448) / 6561) * k3 + h * (T(-212) / 729) * k4);
+                State k6 = eval(t_ + h, y_ + h * (T(9017) / 3168) * k1 + h * (T(-355) / 33) * k2 + h * (T(46732) / 5247) * k3 + h * (T(49) / 176) * k4 + h * (T(-5103) / 18656) * k5);
+
+                // 5th order solution (propagated)
+                State y5 = y_ + h * (T(35) / 384) * k1 + h * (T(500) / 1113) * k3 + h * (T(125) / 192) * k4 + h * (T(-2187) / 6784) * k5 + h * (T(11) / 84) * k6;
+                State k7 = eval(t_ + h, y5);
+
+                // Embedded error y5 - y4
+                State err = h * (T(71) / 57600) * k1 + h * (T(-71) / 16695) * k3 + h * (T(71) / 1920) * k4
+                    + h * (T(-17253) / 339200) * k5 + h * (T(22) / 525) * k6 + h * (T(-1) / 40) * k7;
+                const T e = error_norm(err, y_, y5);
+
+                // PI controller (Hairer & Wanner, dopri5)
+                const T expo1 = static_cast<T>(0.2) - opt_.beta * static_cast<T>(0.75);
+                const T fac11 = std::pow(std::max(e, std::numeric_limits<T>::min()), expo1);
+
+                if (e <= static_cast<T>(1)) {
+                    T fac = fac11 / std::pow(err_old_, opt_.beta);
+                    fac = std::clamp(fac / opt_.safety, static_cast<T>(1) / opt_.max_factor, static_cast<T>(1) / opt_.min_factor);
+                    T h_new = h / fac;
+                    if (rejected) h_new = std::min(h_new, h);
+                    err_old_ = std::max(e, static_cast<T>(1e-4));
+                    err_last_ = e;
+
+                    t_prev_ = t_;
+                    y_prev_ = std::move(y_);
+                    stage_[0] = k1_;
+                    stage_[1] = std::move(k2);
+                    stage_[2] = std::move(k3);
+                    stage_[3] = std::move(k4);
+                    stage_[4] = std::move(k5);
+                    stage_[5] = std::move(k6);
+                    stage_[6] = k7;
+
+                    t_ = last ? t_end_ : t_ + h;
+                    y_ = std::move(y5);
+                    k1_ = std::move(k7); // FSAL
+                    ++stats_.accepted;
+                    // don't let a shortened final step shrink the controller's h
+                    h_ = std::min(last ? std::max(h_new, h_) : h_new, opt_.h_max);
+                    return mathlib::core::error_code::ok;
+                }
+
+                ++stats_.rejected;
+                rejected = true;
+                h_ = h / std::min(static_cast<T>(1) / opt_.min_factor, fac11 / opt_.safety);
+            }
+        }
+
+    private:
+        State eval(T t, const State& y) {
+            ++stats_.f_evals;
+            return f_(t, y);
+        }
+
+        T scale(const State& a, const State& b, std::size_t i) const {
+            using std::abs;
+            return opt_.atol + opt_.rtol * std::max(abs(traits::at(a, i)), abs(traits::at(b, i)));
+        }
+
+        // sqrt(mean((err_i / sc_i)^2)), or max |err_i / sc_i|
+        T error_norm(const State& err, const State& y0, const State& y1) const {
+            using std::abs;
+            T s{};
+            for (std::size_t i = 0; i < traits::size; ++i) {
+                const T r = traits::at(err, i) / scale(y0, y1, i);
+                if (opt_.norm == rk45_norm::max) s = std::max(s, abs(r));
+                else s += r * r;
+            }
+            return opt_.norm == rk45_norm::max ? s : std::sqrt(s / static_cast<T>(traits::size));
+        }
+
+        T rms_scaled(const State& v) const {
+            T s{};
+            for (std::size_t i = 0; i < traits::size; ++i) {
+                const T r = traits::at(v, i) / scale(y_, y_, i);
+                s += r * r;
+            }
+            return std::sqrt(s / static_cast<T>(traits::size));
+        }
+
+        // Hairer, Norsett & Wanner, "Solving ODEs I", II.4 (costs one evaluation)
+        T initial_step() {
+            const T d0 = rms_scaled(y_);
+            const T d1 = rms_scaled(k1_);
+            T h0 = (d0 < static_cast<T>(1e-5) || d1 < static_cast<T>(1e-5))
+                ? static_cast<T>(1e-6) : static_cast<T>(0.01) * d0 / d1;
+            h0 = std::min({ h0, opt_.h_max, t_end_ - t_ });
+            if (h0 <= T{}) return opt_.h_min;
+
+            const State f1 = eval(t_ + h0, y_ + h0 * k1_);
+            const T d2 = rms_scaled(f1 - k1_) / h0;
+            const T dm = std::max(d1, d2);
+            const T h1 = (dm <= static_cast<T>(1e-15))
+                ? std::max(static_cast<T>(1e-6), h0 * static_cast<T>(1e-3))
+                : std::pow(static_cast<T>(0.01) / dm, static_cast<T>(0.2));
+            return std::min(static_cast<T>(100) * h0, h1);
+        }
+
+        F f_;
+        Rk45Options<T> opt_;
+        T t_, t_end_;
+        State y_;
+        State k1_{};
+        T h_{};
+        T err_old_ = static_cast<T>(1e-4);
+        T err_last_{};
+        Rk45Stats stats_{};
+
+        T t_prev_{};
+        State y_prev_{};
+        State stage_[7]{};
+    };
+
+} // namespace mathlib::ode
@@ -0,0 +1,367 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/core/executor.hpp"
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/ode/dopri5.hpp"
+
+namespace mathlib::ode {
+
+    // Default lane count: one 64-byte vector register's worth of T
+    template <typename T>
+    inline constexpr std::size_t default_lanes = 64 / sizeof(T);
+
+    template <typename T, std::size_t W>
+    using Lanes = std::array<T, W>;
+
+    // Structure-of-arrays state for W ensemble members with N components:
+    // y[i][l] is component i of lane l. Lane loops are contiguous so the
+    // compiler can vectorize user right-hand sides and the stepper alike.
+    template <std::size_t N, typename T, std::size_t W>
+    struct Batch {
+        std::array<Lanes<T, W>, N> c{};
+
+        Lanes<T, W>& operator[](std::size_t i) { return c[i]; }
+        const Lanes<T, W>& operator[](std::size_t i) const { return c[i]; }
+
+        friend Batch operator+(const Batch& a, const Batch& b) {
+            Batch out;
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t l = 0; l < W; ++l) out.c[i][l] = a.c[i][l] + b.c[i][l];
+            return out;
+        }
+
+        friend Batch operator-(const Batch& a, const Batch& b) {
+            Batch out;
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t l = 0; l < W; ++l) out.c[i][l] = a.c[i][l] - b.c[i][l];
+            return out;
+        }
+
+        friend Batch operator*(T s, const Batch& a) {
+            Batch out;
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t l = 0; l < W; ++l) out.c[i][l] = s * a.c[i][l];
+            return out;
+        }
+
+        // Per-lane scale (e.g. per-member step sizes)
+        friend Batch operator*(const Lanes<T, W>& s, const Batch& a) {
+            Batch out;
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t l = 0; l < W; ++l) out.c[i][l] = s[l] * a.c[i][l];
+            return out;
+        }
+
+        mathlib::linalg::Vector<N, T> lane(std::size_t l) const {
+            mathlib::linalg::Vector<N, T> v;
+            for (std::size_t i = 0; i < N; ++i) v[i] = c[i][l];
+            return v;
+        }
+
+        void set_lane(std::size_t l, const mathlib::linalg::Vector<N, T>& v) {
+            for (std::size_t i = 0; i < N; ++i) c[i][l] = v[i];
+        }
+    };
+
+    struct EnsembleStats {
+        std::size_t members = 0;
+        std::size_t batches = 0;
+        std::size_t f_evals = 0;    // batched right-hand-side calls
+        std::size_t accepted = 0;   // summed over members
+        std::size_t rejected = 0;
+    };
+
+    namespace detail {
+
+        // f(t, y), or for member-dependent parameters f(t, y, first, active) or
+        // f(t, y, first). Lane l holds member first + l for l < active; a short
+        // final batch is padded up to W lanes with copies of the last member, so
+        // the three-argument form must not index per-member data with
+        // first + l >= members (e.g. clamp it, or take the four-argument form).
+        // Results in padded lanes are discarded.
+        template <typename F, std::size_t N, typename T, std::size_t W>
+        Batch<N, T, W> eval_batch(F& f, const Lanes<T, W>& t, const Batch<N, T, W>& y, std::size_t first,
+            std::size_t active) {
+            if constexpr (std::is_invocable_v<F&, const Lanes<T, W>&, const Batch<N, T, W>&, std::size_t, std::size_t>) {
+                return f(t, y, first, active);
+            }
+            else if constexpr (std::is_invocable_v<F&, const Lanes<T, W>&, const Batch<N, T, W>&, std::size_t>) {
+                (void)active;
+                return f(t, y, first);
+            }
+            else {
+                (void)first;
+                (void)active;
+                return f(t, y);
+            }
+        }
+
+        template <std::size_t N, typename T, std::size_t W>
+        Batch<N, T, W> pack(const std::vector<mathlib::linalg::Vector<N, T>>& y0s, std::size_t first) {
+            Batch<N, T, W> b;
+            for (std::size_t l = 0; l < W; ++l) {
+                // pad a short final batch with copies of the last member
+                b.set_lane(l, y0s[std::min(first + l, y0s.size() - 1)]);
+            }
+            return b;
+        }
+
+        template <typename Sink, std::size_t N, typename T>
+        void emit(Sink& sink, std::size_t member, T t, const mathlib::linalg::Vector<N, T>& y) {
+            if constexpr (!std::is_same_v<std::remove_cvref_t<Sink>, std::nullptr_t>) sink(member, t, y);
+        }
+
+    } // namespace detail
+
+    // Fixed-step RK4 over many initial conditions. Members are packed W at a
+    // time and advanced in lockstep; batches run concurrently on exec. f takes
+    // a whole Batch (see detail::eval_batch for the member-dependent forms and
+    // the padding of a short final batch). The sink
+    // is called as sink(member, t, y) after every step (calls for one member
+    // are ordered; different batches may call concurrently). Returns the final
+    // state of every member.
+    template <std::size_t W, typename F, std::size_t N, typename T, typename Exec, typename Sink>
+        requires core::executor<std::remove_cvref_t<Exec>>
+    std::vector<mathlib::linalg::Vector<N, T>> solve_ensemble_rk4(F f, T t0,
+        const std::vector<mathlib::linalg::Vector<N, T>>& y0s, T t1, T h, Exec&& exec, Sink&& sink,
+        EnsembleStats* stats = nullptr) {
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_ensemble_rk4(): h must be > 0"));
+        if (t1 < t0) MATHLIB_THROW(mathlib::core::domain_error("solve_ensemble_rk4(): t1 must be >= t0"));
+
+        const std::size_t members = y0s.size();
+        const std::size_t batches = (members + W - 1) / W;
+        std::vector<mathlib::linalg::Vector<N, T>> out(members);
+        std::vector<std::size_t> steps(batches);
+
+        exec.bulk(batches, [&](std::size_t b) {
+            const std::size_t first = b * W;
+            const std::size_t active = std::min(W, members - first);
+            Batch<N, T, W> y = detail::pack<N, T, W>(y0s, first);
+            Lanes<T, W> tl;
+            T t = t0;
+            tl.fill(t);
+            for (std::size_t l = 0; l < active; ++l) detail::emit(sink, first + l, t, y0s[first + l]);
+
+            std::size_t n_steps = 0;
+            while (t < t1) {
+                const T step = std::min(h, t1 - t);
+                Lanes<T, W> th, tf;
+                th.fill(t + step / 2);
+                tf.fill(t + step);
+
+                auto k1 = detail::eval_batch(f, tl, y, first, active);
+                auto k2 = detail::eval_batch(f, th, y + (step / 2) * k1, first, active);
+                auto k3 = detail::eval_batch(f, th, y + (step / 2) * k2, first, active);
+                auto k4 = detail::eval_batch(f, tf, y + step * k3, first, active);
+                ++n_steps;
+
+                y = y + (step / 6) * (k1 + static_cast<T>(2) * k2 + static_cast<T>(2) * k3 + k4);
+                t += step;
+                tl.fill(t);
+                for (std::size_t l = 0; l < active; ++l) detail::emit(sink, first + l, t, y.lane(l));
+            }
+            for (std::size_t l = 0; l < active; ++l) out[first + l] = y.lane(l);
+            steps[b] = n_steps;
+            });
+
+        if (stats) {
+            *stats = EnsembleStats{};
+            stats->members = members;
+            stats->batches = batches;
+            for (std::size_t s : steps) stats->f_evals += 4 * s;
+            stats->accepted = members ? steps[0] * members : 0;
+        }
+        return out;
+    }
+
+    // Adaptive Dormand-Prince 5(4) over many initial conditions. Every lane keeps
+    // its own t, h and controller state; all lanes evaluate the same stage
+    // together, finished lanes are masked (h = 0), and each lane accepts or
+    // rejects independently. FSAL is kept per lane.
+    template <std::size_t W, typename F, std::size_t N, typename T, typename Exec, typename Sink>
+        requires core::executor<std::remove_cvref_t<Exec>>
+    std::vector<mathlib::linalg::Vector<N, T>> solve_ensemble_rk45(F f, T t0,
+        const std::vector<mathlib::linalg::Vector<N, T>>& y0s, T t1, const Rk45Options<T>& opt,
+        Exec&& exec, Sink&& sink, EnsembleStats* stats = nullptr) {
+        if (opt.rtol < T{} || opt.atol < T{} || (opt.rtol == T{} && opt.atol == T{})) {
+            MATHLIB_THROW(mathlib::core::domain_error("solve_ensemble_rk45(): need rtol >= 0, atol >= 0, not both zero"));
+        }
+        if (t1 < t0) MATHLIB_THROW(mathlib::core::domain_error("solve_ensemble_rk45(): t1 must be >= t0"));
+
+        const std::size_t members = y0s.size();
+        const std::size_t batches = (members + W - 1) / W;
+        std::vector<mathlib::linalg::Vector<N, T>> out(members);
+        std::vector<EnsembleStats> per(batches);
+
+        exec.bulk(batches, [&](std::size_t b) {
+            using B = Batch<N, T, W>;
+            const std::size_t first = b * W;
+            const std::size_t active = std::min(W, members - first);
+            EnsembleStats& st = per[b];
+
+            B y = detail::pack<N, T, W>(y0s, first);
+            Lanes<T, W> t, h, err_old;
+            std::array<bool, W> done{}, rejected{};
+            t.fill(t0);
+            err_old.fill(static_cast<T>(1e-4));
+            for (std::size_t l = 0; l < W; ++l) done[l] = (l >= active) || t0 >= t1;
+            for (std::size_t l = 0; l < active; ++l) detail::emit(sink, first + l, t0, y0s[first + l]);
+
+            B k1 = detail::eval_batch(f, t, y, first, active);
+            ++st.f_evals;
+
+            auto scale = [&](const B& y0, const B& y1, std::size_t i, std::size_t l) {
+                return opt.atol + opt.rtol * std::max(std::abs(y0.c[i][l]), std::abs(y1.c[i][l]));
+            };
+
+            // Same initial step heuristic as Dopri5, per lane (one batched probe)
+            {
+                Lanes<T, W> h0;
+                for (std::size_t l = 0; l < W; ++l) {
+                    T d0{}, d1{};
+                    for (std::size_t i = 0; i < N; ++i) {
+                        const T sc = scale(y, y, i, l);
+                        d0 += (y.c[i][l] / sc) * (y.c[i][l] / sc);
+                        d1 += (k1.c[i][l] / sc) * (k1.c[i][l] / sc);
+                    }
+                    d0 = std::sqrt(d0 / N);
+                    d1 = std::sqrt(d1 / N);
+                    T hh = (d0 < static_cast<T>(1e-5) || d1 < static_cast<T>(1e-5)) ? static_cast<T>(1e-6) : static_cast<T>(0.01) * d0 / d1;
+                    h0[l] = std::max(std::min({ hh, opt.h_max, t1 - t0 }), opt.h_min);
+                }
+                if (opt.h0 > T{}) {
+                    h.fill(std::clamp(opt.h0, opt.h_min, opt.h_max));
+                }
+                else {
+                    Lanes<T, W> tp;
+                    for (std::size_t l = 0; l < W; ++l) tp[l] = t0 + h0[l];
+                    const B f1 = detail::eval_batch(f, tp, y + h0 * k1, first, active);
+                    ++st.f_evals;
+                    for (std::size_t l = 0; l < W; ++l) {
+                        T d1{}, d2{};
+                        for (std::size_t i = 0; i < N; ++i) {
+                            const T sc = scale(y, y, i, l);
+                            d1 += (k1.c[i][l] / sc) * (k1.c[i][l] / sc);
+                            const T df = (f1.c[i][l] - k1.c[i][l]) / sc;
+                            d2 += df * df;
+                        }
+                        d1 = std::sqrt(d1 / N);
+                        d2 = std::sqrt(d2 / N) / h0[l];
+                        const T dm = std::max(d1, d2);
+                        const T h1 = (dm <= static_cast<T>(1e-15)) ? std::max(static_cast<T>(1e-6), h0[l] * static_cast<T>(1e-3))
+                            : std::pow(static_cast<T>(0.01) / dm, static_cast<T>(0.2));
+                        h[l] = std::clamp(std::min(static_cast<T>(100) * h0[l], h1), opt.h_min, opt.h_max);
+                    }
+                }
+            }
+
+            const T expo1 = static_cast<T>(0.2) - opt.beta * static_cast<T>(0.75);
+            for (std::size_t iter = 0;; ++iter) {
+                bool any = false;
+                Lanes<T, W> hs;
+                std::array<bool, W> last{};
+                for (std::size_t l = 0; l < W; ++l) {
+                    if (done[l]) {
+                        hs[l] = T{};
+                        continue;
+                    }
+                    any = true;
+                    if (h[l] < opt.h_min) MATHLIB_THROW(mathlib::core::domain_error("solve_ensemble_rk45(): step underflow (h < h_min)"));
+                    last[l] = t[l] + h[l] >= t1;
+                    hs[l] = last[l] ? t1 - t[l] : h[l];
+                }
+                if (!any) break;
+                if (iter >= opt.max_steps) MATHLIB_THROW(mathlib::core::domain_error("solve_ensemble_rk45(): too many steps"));
+
+                auto at = [&](T c) {
+                    Lanes<T, W> tt;
+                    for (std::size_t l = 0; l < W; ++l) tt[l] = t[l] + c * hs[l];
+                    return tt;
+                };
+
+                const B k2 = detail::eval_batch(f, at(T(1) / 5), y + hs * ((T(1) / 5) * k1), first, active);
+                const B k3 = detail::eval_batch(f, at(T(3) / 10), y + hs * ((T(3) / 40) * k1 + (T(9) / 40) * k2), first, active);
+                const B k4 = detail::eval_batch(f, at(T(4) / 5), y + hs * ((T(44) / 45) * k1 + (T(-56) / 15) * k2 + (T(32) / 9) * k3), first, active);
+                const B k5 = detail::eval_batch(f, at(T(8) / 9), y + hs * ((T(19372) / 6561) * k1 + (T(-25360) / 2187) * k2 + (T(64448) / 6561) * k3 + (T(-212) / 729) * k4), first, active);
+                const B k6 = detail::eval_batch(f, at(T(1)), y + hs * ((T(9017) / 3168) * k1 + (T(-355) / 33) * k2 + (T(46732) / 5247) * k3 + (T(49) / 176) * k4 + (T(-5103) / 18656) * k5), first, active);
+                const B y5 = y + hs * ((T(35) / 384) * k1 + (T(500) / 1113) * k3 + (T(125) / 192) * k4 + (T(-2187) / 6784) * k5 + (T(11) / 84) * k6);
+                const B k7 = detail::eval_batch(f, at(T(1)), y5, first, active);
+                st.f_evals += 6;
+                const B err = hs * ((T(71) / 57600) * k1 + (T(-71) / 16695) * k3 + (T(71) / 1920) * k4
+                    + (T(-17253) / 339200) * k5 + (T(22) / 525) * k6 + (T(-1) / 40) * k7);
+
+                for (std::size_t l = 0; l < W; ++l) {
+                    if (done[l]) continue;
+                    T s{};
+                    for (std::size_t i = 0; i < N; ++i) {
+                        const T r = err.c[i][l] / scale(y, y5, i, l);
+                        if (opt.norm == rk45_norm::max) s = std::max(s, std::abs(r));
+                        else s += r * r;
+                    }
+                    const T e = opt.norm == rk45_norm::max ? s : std::sqrt(s / N);
+                    const T fac11 = std::pow(std::max(e, std::numeric_limits<T>::min()), expo1);
+
+                    if (e <= static_cast<T>(1)) {
+                        T fac = fac11 / std::pow(err_old[l], opt.beta);
+                        fac = std::clamp(fac / opt.safety, static_cast<T>(1) / opt.max_factor, static_cast<T>(1) / opt.min_factor);
+                        T h_new = hs[l] / fac;
+                        if (rejected[l]) h_new = std::min(h_new, hs[l]);
+                        err_old[l] = std::max(e, static_cast<T>(1e-4));
+                        rejected[l] = false;
+
+                        t[l] = last[l] ? t1 : t[l] + hs[l];
+                        for (std::size_t i = 0; i < N; ++i) {
+                            y.c[i][l] = y5.c[i][l];
+                            k1.c[i][l] = k7.c[i][l]; // FSAL
+                        }
+                        h[l] = std::min(last[l] ? std::max(h_new, h[l]) : h_new, opt.h_max);
+                        done[l] = last[l];
+                        ++st.accepted;
+                        if (l < active) detail::emit(sink, first + l, t[l], y.lane(l));
+                    }
+                    else {
+                        ++st.rejected;
+                        rejected[l] = true;
+                        h[l] = hs[l] / std::min(static_cast<T>(1) / opt.min_factor, fac11 / opt.safety);
+                    }
+                }
+            }
+            for (std::size_t l = 0; l < active; ++l) out[first + l] = y.lane(l);
+            });
+
+        if (stats) {
+            *stats = EnsembleStats{};
+            stats->members = members;
+            stats->batches = batches;
+            for (const auto& s : per) {
+                stats->f_evals += s.f_evals;
+                stats->accepted += s.accepted;
+                stats->rejected += s.rejected;
+            }
+        }
+        return out;
+    }
+
+    // Convenience overloads: default lane count, final states only, serial executor
+    template <typename F, std::size_t N, typename T>
+    std::vector<mathlib::linalg::Vector<N, T>> solve_ensemble_rk4(F f, T t0,
+        const std::vector<mathlib::linalg::Vector<N, T>>& y0s, T t1, T h) {
+        return solve_ensemble_rk4<default_lanes<T>>(f, t0, y0s, t1, h, core::inline_executor{}, nullptr);
+    }
+
+    template <typename F, std::size_t N, typename T>
+    std::vector<mathlib::linalg::Vector<N, T>> solve_ensemble_rk45(F f, T t0,
+        const std::vector<mathlib::linalg::Vector<N, T>>& y0s, T t1, const Rk45Options<T>& opt = {}) {
+        return solve_ensemble_rk45<default_lanes<T>>(f, t0, y0s, t1, opt, core::inline_executor{}, nullptr);
+    }
+
+} // namespace mathlib::ode
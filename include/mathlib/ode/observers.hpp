@@ -0,0 +1,135 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mathlib/core/error.hpp"
+
+namespace mathlib::ode {
+
+    // An observer is called as obs(t, y) for every accepted step (and the initial
+    // state). It may return void, or bool where false asks the solver to stop.
+    template <typename O, typename State, typename T>
+    concept observer = std::invocable<O&, const T&, const State&>;
+
+    namespace detail {
+
+        template <typename O, typename State, typename T>
+        bool notify(O& obs, const T& t, const State& y) {
+            if constexpr (std::is_void_v<std::invoke_result_t<O&, const T&, const State&>>) {
+                obs(t, y);
+                return true;
+            }
+            else {
+                return static_cast<bool>(obs(t, y));
+            }
+        }
+
+    } // namespace detail
+
+    // Keeps only the most recent sample (O(State) memory).
+    template <typename State, typename T>
+    struct final_state_observer {
+        T t{};
+        State y{};
+        std::size_t samples = 0;
+
+        void operator()(const T& tt, const State& yy) {
+            t = tt;
+            y = yy;
+            ++samples;
+        }
+    };
+
+    // Forwards every k-th sample (the initial state is sample 0).
+    template <typename O>
+    struct decimating_observer {
+        O inner;
+        std::size_t k;
+        std::size_t count = 0;
+
+        template <typename T, typename State>
+        bool operator()(const T& t, const State& y) {
+            const bool forward = (count++ % k) == 0;
+            return forward ? detail::notify(inner, t, y) : true;
+        }
+    };
+
+    template <typename O>
+    decimating_observer<O> decimate(std::size_t k, O&& inner) {
+        if (k == 0) MATHLIB_THROW(mathlib::core::domain_error("decimate(): k must be > 0"));
+        return { std::forward<O>(inner), k };
+    }
+
+    // Forwards the solution at fixed output times (ascending), linearly
+    // interpolated between the two solver steps that bracket each time.
+    template <typename State, typename T, typename O>
+    struct time_sampler {
+        std::vector<T> times;
+        O inner;
+        std::size_t next = 0;
+        bool have_prev = false;
+        T t_prev{};
+        State y_prev{};
+
+        bool operator()(const T& t, const State& y) {
+            while (next < times.size() && times[next] <= t) {
+                const T tq = times[next++];
+                bool go;
+                if (!have_prev || tq == t || t == t_prev) {
+                    go = detail::notify(inner, tq, y);
+                }
+                else {
+                    const T w = (tq - t_prev) / (t - t_prev);
+                    go = detail::notify(inner, tq, State(y_prev + w * (y - y_prev)));
+                }
+                if (!go) return false;
+            }
+            t_prev = t;
+            y_prev = y;
+            have_prev = true;
+            return true;
+        }
+    };
+
+    template <typename State, typename T, typename O>
+    time_sampler<State, T, O> sample_at(std::vector<T> times, O&& inner) {
+        for (std::size_t i = 1; i < times.size(); ++i) {
+            if (times[i] < times[i - 1]) MATHLIB_THROW(mathlib::core::domain_error("sample_at(): times must be ascending"));
+        }
+        return { std::move(times), std::forward<O>(inner) };
+    }
+
+    // Bounded ring buffer holding the last `capacity` samples, oldest first.
+    template <typename State, typename T>
+    class ring_buffer_observer {
+    public:
+        explicit ring_buffer_observer(std::size_t capacity,
+            std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+            : buf_(capacity, mr) {
+            if (capacity == 0) MATHLIB_THROW(mathlib::core::domain_error("ring_buffer_observer(): capacity must be > 0"));
+        }
+
+        void operator()(const T& t, const State& y) {
+            buf_[head_] = { t, y };
+            head_ = (head_ + 1) % buf_.size();
+            if (size_ < buf_.size()) ++size_;
+        }
+
+        std::size_t size() const { return size_; }
+        std::size_t capacity() const { return buf_.size(); }
+
+        const std::pair<T, State>& operator[](std::size_t i) const {
+            return buf_[(head_ + buf_.size() - size_ + i) % buf_.size()];
+        }
+
+    private:
+        std::pmr::vector<std::pair<T, State>> buf_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+    };
+
+} // namespace mathlib::ode
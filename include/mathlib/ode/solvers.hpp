@@ -3,8 +3,14 @@
 #include <utility>
 #include <cmath>
 #include <algorithm>
+#include <memory_resource>
 
 #include "mathlib/core/error.hpp"
+#include "mathlib/core/expected.hpp"
+#include "mathlib/core/instrument.hpp"
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/ode/observers.hpp"
+#include "mathlib/ode/dopri5.hpp"
 
 namespace mathlib::ode {
 
@@ -12,6 +18,12 @@ namespace mathlib::ode {
     template <typename State, typename T>
     using Trajectory = std::vector<std::pair<T, State>>;
 
+    namespace pmr {
+        // Trajectory drawing its storage from a std::pmr::memory_resource
+        template <typename State, typename T>
+        using Trajectory = std::pmr::vector<std::pair<T, State>>;
+    } // namespace pmr
+
     // Utility: max-norm for error control (works for double and your Vector)
     inline double max_norm(double x) { return std::abs(x); }
 
@@ -22,41 +34,79 @@ namespace mathlib::ode {
         return m;
     }
 
-    // Euler (fixed step)
-    template <typename F, typename State, typename T>
-    Trajectory<State, T> solve_euler(F f, T t0, State y0, T t1, T h) {
-        if (h <= T{}) throw mathlib::core::domain_error("solve_euler(): h must be > 0");
+    // Euler (fixed step), streaming each step to obs; returns the final (t, y).
+    // Nothing is stored, so memory is O(State) regardless of the step count.
+    // Stats records one evaluation and one accepted step per step.
+    template <typename F, typename State, typename T, typename Obs, typename Stats>
+        requires observer<Obs, State, T> && core::stats_policy<Stats>
+    std::pair<T, State> solve_euler(F f, T t0, State y0, T t1, T h, Obs&& obs, Stats& stats) {
+        auto timer = stats.scoped_timer();
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_euler(): h must be > 0"));
         if (t1 < t0) std::swap(t0, t1);
 
-        Trajectory<State, T> out;
-        out.reserve(static_cast<std::size_t>((t1 - t0) / h) + 2);
-
         T t = t0;
         State y = y0;
-        out.push_back({ t, y });
+        if (!detail::notify(obs, t, y)) return { t, y };
 
+        [[maybe_unused]] std::size_t steps = 0;
         while (t < t1) {
             T step = std::min(h, t1 - t);
             y = y + step * f(t, y);
             t += step;
-            out.push_back({ t, y });
+            stats.add_evals(1);
+            stats.add_accepted();
+            ++steps;
+            if constexpr (Stats::tracing) {
+                stats.event({ "solve_euler", "step", steps, static_cast<double>(t), static_cast<double>(step), 0.0 });
+            }
+            if (!detail::notify(obs, t, y)) break;
         }
-        return out;
+        return { t, y };
     }
 
-    // RK4 (fixed step)
+    template <typename F, typename State, typename T, typename Obs>
+        requires observer<Obs, State, T>
+    std::pair<T, State> solve_euler(F f, T t0, State y0, T t1, T h, Obs&& obs) {
+        core::null_stats stats;
+        return solve_euler(std::move(f), t0, std::move(y0), t1, h, std::forward<Obs>(obs), stats);
+    }
+
+    // Euler (fixed step)
     template <typename F, typename State, typename T>
-    Trajectory<State, T> solve_rk4(F f, T t0, State y0, T t1, T h) {
-        if (h <= T{}) throw mathlib::core::domain_error("solve_rk4(): h must be > 0");
-        if (t1 < t0) std::swap(t0, t1);
+    Trajectory<State, T> solve_euler(F f, T t0, State y0, T t1, T h) {
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_euler(): h must be > 0"));
 
         Trajectory<State, T> out;
-        out.reserve(static_cast<std::size_t>((t1 - t0) / h) + 2);
+        out.reserve(static_cast<std::size_t>(std::abs(t1 - t0) / h) + 2);
+        solve_euler(f, t0, y0, t1, h, [&out](const T& t, const State& y) { out.push_back({ t, y }); });
+        return out;
+    }
+
+    // Euler (fixed step), trajectory allocated from mr
+    template <typename F, typename State, typename T>
+    pmr::Trajectory<State, T> solve_euler(F f, T t0, State y0, T t1, T h, std::pmr::memory_resource* mr) {
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_euler(): h must be > 0"));
+
+        pmr::Trajectory<State, T> out(mr);
+        out.reserve(static_cast<std::size_t>(std::abs(t1 - t0) / h) + 2);
+        solve_euler(f, t0, y0, t1, h, [&out](const T& t, const State& y) { out.push_back({ t, y }); });
+        return out;
+    }
+
+    // RK4 (fixed step), streaming each step to obs; returns the final (t, y).
+    // Stats records four evaluations and one accepted step per step.
+    template <typename F, typename State, typename T, typename Obs, typename Stats>
+        requires observer<Obs, State, T> && core::stats_policy<Stats>
+    std::pair<T, State> solve_rk4(F f, T t0, State y0, T t1, T h, Obs&& obs, Stats& stats) {
+        auto timer = stats.scoped_timer();
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_rk4(): h must be > 0"));
+        if (t1 < t0) std::swap(t0, t1);
 
         T t = t0;
         State y = y0;
-        out.push_back({ t, y });
+        if (!detail::notify(obs, t, y)) return { t, y };
 
+        [[maybe_unused]] std::size_t steps = 0;
         while (t < t1) {
             T step = std::min(h, t1 - t);
 
@@ -67,70 +117,184 @@ namespace mathlib::ode {
 
             y = y + (step / 6) * (k1 + 2 * k2 + 2 * k3 + k4);
             t += step;
-            out.push_back({ t, y });
+            stats.add_evals(4);
+            stats.add_accepted();
+            ++steps;
+            if constexpr (Stats::tracing) {
+                stats.event({ "solve_rk4", "step", steps, static_cast<double>(t), static_cast<double>(step), 0.0 });
+            }
+            if (!detail::notify(obs, t, y)) break;
         }
 
-        return out;
+        return { t, y };
     }
 
-    // RK45 adaptive (DormandPrince 5(4))
+    template <typename F, typename State, typename T, typename Obs>
+        requires observer<Obs, State, T>
+    std::pair<T, State> solve_rk4(F f, T t0, State y0, T t1, T h, Obs&& obs) {
+        core::null_stats stats;
+        return solve_rk4(std::move(f), t0, std::move(y0), t1, h, std::forward<Obs>(obs), stats);
+    }
+
+    // RK4 (fixed step)
     template <typename F, typename State, typename T>
-    Trajectory<State, T> solve_rk45(F f, T t0, State y0, T t1,
-        T h0 = static_cast<T>(1e-2),
-        T eps = static_cast<T>(1e-9),
-        T h_min = static_cast<T>(1e-10),
-        T h_max = static_cast<T>(1.0)) {
-        if (h0 <= T{}) throw mathlib::core::domain_error("solve_rk45(): h0 must be > 0");
-        if (eps <= T{}) throw mathlib::core::domain_error("solve_rk45(): eps must be > 0");
-        if (t1 < t0) std::swap(t0, t1);
+    Trajectory<State, T> solve_rk4(F f, T t0, State y0, T t1, T h) {
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_rk4(): h must be > 0"));
 
         Trajectory<State, T> out;
-        out.reserve(1024);
+        out.reserve(static_cast<std::size_t>(std::abs(t1 - t0) / h) + 2);
+        solve_rk4(f, t0, y0, t1, h, [&out](const T& t, const State& y) { out.push_back({ t, y }); });
+        return out;
+    }
 
-        T t = t0;
-        State y = y0;
-        T h = std::clamp(h0, h_min, h_max);
+    // RK4 (fixed step), trajectory allocated from mr
+    template <typename F, typename State, typename T>
+    pmr::Trajectory<State, T> solve_rk4(F f, T t0, State y0, T t1, T h, std::pmr::memory_resource* mr) {
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_rk4(): h must be > 0"));
 
-        out.push_back({ t, y });
+        pmr::Trajectory<State, T> out(mr);
+        out.reserve(static_cast<std::size_t>(std::abs(t1 - t0) / h) + 2);
+        solve_rk4(f, t0, y0, t1, h, [&out](const T& t, const State& y) { out.push_back({ t, y }); });
+        return out;
+    }
 
-        while (t < t1) {
-            if (h < h_min) throw mathlib::core::domain_error("solve_rk45(): step underflow (h < h_min)");
-            if (t + h > t1) h = t1 - t;
+    // RK45 adaptive (DormandPrince 5(4)) with full control over tolerances,
+    // streaming each accepted step to obs. See ode/dopri5.hpp.
+    template <typename F, typename State, typename T, typename Obs>
+        requires observer<Obs, State, T>
+    std::pair<T, State> solve_rk45(F f, T t0, State y0, T t1, const Rk45Options<T>& opt, Obs&& obs,
+        Rk45Stats* stats = nullptr) {
+        Dopri5<F, State, T> stepper(std::move(f), t0, std::move(y0), t1, opt);
+        if (detail::notify(obs, stepper.t(), stepper.y())) {
+            while (!stepper.done()) {
+                stepper.step();
+                if (!detail::notify(obs, stepper.t(), stepper.y())) break;
+            }
+        }
+        if (stats) *stats = stepper.stats();
+        return { stepper.t(), stepper.y() };
+    }
 
-            // DormandPrince coefficients
-            auto k1 = f(t, y);
-            auto k2 = f(t + h * (T(1) / 5), y + h * (T(1) / 5) * k1);
-            auto k3 = f(t + h * (T(3) / 10), y + h * (T(3) / 40) * k1 + h * (T(9) / 40) * k2);
-            auto k4 = f(t + h * (T(4) / 5), y + h * (T(44) / 45) * k1 + h * (T(-56) / 15) * k2 + h * (T(32) / 9) * k3);
-            auto k5 = f(t + h * (T(8) / 9), y + h * (T(19372) / 6561) * k1 + h * (T(-25360) / 2187) * k2 + h * (T(64448) / 6561) * k3 + h * (T(-212) / 729) * k4);
-            auto k6 = f(t + h, y + h * (T(9017) / 3168) * k1 + h * (T(-355) / 33) * k2 + h * (T(46732) / 5247) * k3 + h * (T(49) / 176) * k4 + h * (T(-5103) / 18656) * k5);
-
-            // 5th order solution
-            State y5 = y + h * (T(35) / 384) * k1 + h * (T(500) / 1113) * k3 + h * (T(125) / 192) * k4 + h * (T(-2187) / 6784) * k5 + h * (T(11) / 84) * k6;
-
-            // 4th order solution (error estimate)
-            auto k7 = f(t + h, y5);
-            State y4 = y + h * (T(5179) / 57600) * k1 + h * (T(7571) / 16695) * k3 + h * (T(393) / 640) * k4
-                + h * (T(-92097) / 339200) * k5 + h * (T(187) / 2100) * k6 + h * (T(1) / 40) * k7;
-
-            State err = y5 - y4;
-            T err_norm = static_cast<T>(max_norm(err));
-
-            // Accept/reject step
-            if (err_norm <= eps || err_norm == T{}) {
-                t += h;
-                y = y5;
-                out.push_back({ t, y });
+    // Same, with stats: evaluations, accepted/rejected steps, the last error
+    // norm, one "step" event per accepted step (value = h, error = scaled
+    // error norm) and converged = reached t1 (false if obs stopped early).
+    template <typename F, typename State, typename T, typename Obs, typename Stats>
+        requires observer<Obs, State, T> && core::stats_policy<Stats>
+    std::pair<T, State> solve_rk45(F f, T t0, State y0, T t1, const Rk45Options<T>& opt, Obs&& obs,
+        Stats& stats) {
+        auto timer = stats.scoped_timer();
+        Dopri5<F, State, T> stepper(std::move(f), t0, std::move(y0), t1, opt);
+        Rk45Stats seen = stepper.stats();
+        stats.add_evals(seen.f_evals);
+        if (detail::notify(obs, stepper.t(), stepper.y())) {
+            while (!stepper.done()) {
+                stepper.step();
+                const Rk45Stats& now = stepper.stats();
+                stats.add_evals(now.f_evals - seen.f_evals);
+                stats.add_rejected(now.rejected - seen.rejected);
+                stats.add_accepted();
+                stats.add_iteration();
+                stats.set_error(static_cast<double>(stepper.error()));
+                if constexpr (Stats::tracing) {
+                    stats.event({ "solve_rk45", "step", now.accepted, static_cast<double>(stepper.t()),
+                        static_cast<double>(stepper.h_last()), static_cast<double>(stepper.error()) });
+                }
+                seen = now;
+                if (!detail::notify(obs, stepper.t(), stepper.y())) break;
             }
+        }
+        stats.set_converged(stepper.done());
+        return { stepper.t(), stepper.y() };
+    }
+
+    template <typename F, typename State, typename T>
+    Trajectory<State, T> solve_rk45(F f, T t0, State y0, T t1, const Rk45Options<T>& opt,
+        Rk45Stats* stats = nullptr) {
+        Trajectory<State, T> out;
+        out.reserve(1024);
+        solve_rk45(f, t0, y0, t1, opt, [&out](const T& t, const State& y) { out.push_back({ t, y }); }, stats);
+        return out;
+    }
 
-            // Update h (classic controller)
-            T safety = static_cast<T>(0.9);
-            T power = static_cast<T>(0.2); // 1/5
-            T factor = (err_norm == T{}) ? static_cast<T>(5) : safety * std::pow(eps / err_norm, power);
-            factor = std::clamp(factor, static_cast<T>(0.2), static_cast<T>(5.0));
-            h = std::clamp(h * factor, h_min, h_max);
+    // RK45 with the trajectory allocated from mr (e.g. a core::request_arena)
+    template <typename F, typename State, typename T>
+    pmr::Trajectory<State, T> solve_rk45(F f, T t0, State y0, T t1, const Rk45Options<T>& opt,
+        std::pmr::memory_resource* mr, Rk45Stats* stats = nullptr) {
+        pmr::Trajectory<State, T> out(mr);
+        out.reserve(1024);
+        solve_rk45(f, t0, y0, t1, opt, [&out](const T& t, const State& y) { out.push_back({ t, y }); }, stats);
+        return out;
+    }
+
+    // Non-throwing solve_rk45: bad options give invalid_argument, a stalled
+    // controller step_underflow or too_many_steps. Steps accepted before the
+    // failure have already been passed to obs and are counted in *stats.
+    template <typename F, typename State, typename T, typename Obs>
+        requires observer<Obs, State, T>
+    core::expected<std::pair<T, State>, core::error_code> try_solve_rk45(F f, T t0, State y0, T t1,
+        const Rk45Options<T>& opt, Obs&& obs, Rk45Stats* stats = nullptr) noexcept {
+        if (Dopri5<F, State, T>::check_options(opt, t0, t1)) return core::fail(core::error_code::invalid_argument);
+        Dopri5<F, State, T> stepper(std::move(f), t0, std::move(y0), t1, opt);
+        core::error_code status = core::error_code::ok;
+        if (detail::notify(obs, stepper.t(), stepper.y())) {
+            while (!stepper.done()) {
+                status = stepper.try_step();
+                if (status != core::error_code::ok) break;
+                if (!detail::notify(obs, stepper.t(), stepper.y())) break;
+            }
         }
+        if (stats) *stats = stepper.stats();
+        if (status != core::error_code::ok) return core::fail(status);
+        return std::pair<T, State>{ stepper.t(), stepper.y() };
+    }
+
+    template <typename F, typename State, typename T>
+    core::expected<Trajectory<State, T>, core::error_code> try_solve_rk45(F f, T t0, State y0, T t1,
+        const Rk45Options<T>& opt, Rk45Stats* stats = nullptr) noexcept {
+        Trajectory<State, T> out;
+        out.reserve(1024);
+        auto r = try_solve_rk45(std::move(f), t0, std::move(y0), t1, opt,
+            [&out](const T& t, const State& y) { out.push_back({ t, y }); }, stats);
+        if (!r) return core::fail(r.error());
+        return out;
+    }
+
+    // RK45 adaptive (DormandPrince 5(4)), streaming each accepted step to obs.
+    // A step is accepted when every component of the embedded error estimate
+    // is <= eps in magnitude (max norm, rtol = 0), as before Rk45Options; the
+    // options overload defaults to the RMS norm instead.
+    template <typename F, typename State, typename T, typename Obs>
+        requires observer<Obs, State, T>
+    std::pair<T, State> solve_rk45(F f, T t0, State y0, T t1, Obs&& obs,
+        T h0 = static_cast<T>(1e-2),
+        T eps = static_cast<T>(1e-9),
+        T h_min = static_cast<T>(1e-10),
+        T h_max = static_cast<T>(1.0)) {
+        if (h0 <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_rk45(): h0 must be > 0"));
+        if (eps <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_rk45(): eps must be > 0"));
+        if (t1 < t0) std::swap(t0, t1);
 
+        Rk45Options<T> opt;
+        opt.rtol = T{};
+        opt.atol = eps;
+        opt.norm = rk45_norm::max;
+        opt.h0 = h0;
+        opt.h_min = h_min;
+        opt.h_max = h_max;
+        return solve_rk45(std::move(f), t0, std::move(y0), t1, opt, std::forward<Obs>(obs));
+    }
+
+    // RK45 adaptive (DormandPrince 5(4))
+    template <typename F, typename State, typename T>
+    Trajectory<State, T> solve_rk45(F f, T t0, State y0, T t1,
+        T h0 = static_cast<T>(1e-2),
+        T eps = static_cast<T>(1e-9),
+        T h_min = static_cast<T>(1e-10),
+        T h_max = static_cast<T>(1.0)) {
+        Trajectory<State, T> out;
+        out.reserve(1024);
+        solve_rk45(f, t0, y0, t1, [&out](const T& t, const State& y) { out.push_back({ t, y }); },
+            h0, eps, h_min, h_max);
         return out;
     }
 
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+#include "mathlib/linalg/vector.hpp"
+
+namespace mathlib::ode {
+
+    // Component access for the state types the solvers understand:
+    // floating-point scalars and linalg::Vector<N,T>.
+    template <typename State>
+    struct state_traits;
+
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    struct state_traits<T> {
+        using value_type = T;
+        static constexpr std::size_t size = 1;
+        static constexpr T& at(T& s, std::size_t) { return s; }
+        static constexpr const T& at(const T& s, std::size_t) { return s; }
+    };
+
+    template <std::size_t N, typename T>
+    struct state_traits<mathlib::linalg::Vector<N, T>> {
+        using value_type = T;
+        static constexpr std::size_t size = N;
+        static constexpr T& at(mathlib::linalg::Vector<N, T>& s, std::size_t i) { return s[i]; }
+        static constexpr const T& at(const mathlib::linalg::Vector<N, T>& s, std::size_t i) { return s[i]; }
+    };
+
+} // namespace mathlib::ode
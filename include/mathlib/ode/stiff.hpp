@@ -0,0 +1,457 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "mathlib/calculus/jacobian.hpp"
+#include "mathlib/core/error.hpp"
+#include "mathlib/linalg/lu.hpp"
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/ode/observers.hpp"
+#include "mathlib/ode/solvers.hpp"
+
+namespace mathlib::ode {
+
+    // Implicit integrators for stiff systems y' = f(t, y), y in R^N.
+    // The Jacobian df/dy comes from a user callable jac(t, y) -> Matrix<N,N,T>
+    // (analytic or AD) or from forward differences, which honour an optional
+    // band structure to cut the evaluations per Jacobian to lower + upper + 1.
+
+    template <typename T>
+    struct StiffOptions {
+        T rtol = static_cast<T>(1e-6);
+        T atol = static_cast<T>(1e-9);
+        T h0 = T{};                                       // initial step (0 = automatic)
+        T h_min = static_cast<T>(1e-14);
+        T h_max = std::numeric_limits<T>::infinity();
+        std::size_t max_steps = 1000000;
+        std::size_t max_order = 5;                        // BDF only (1..5)
+        std::size_t lower_bandwidth = static_cast<std::size_t>(-1); // finite-difference Jacobian band
+        std::size_t upper_bandwidth = static_cast<std::size_t>(-1);
+        T fd_step = T{};                                  // 0 = sqrt(eps)
+        bool autonomous = false;                          // f does not depend on t: skip df/dt (Rosenbrock only)
+    };
+
+    struct StiffStats {
+        std::size_t accepted = 0;
+        std::size_t rejected = 0;
+        std::size_t f_evals = 0;            // including finite-difference Jacobians
+        std::size_t jacobian_evals = 0;
+        std::size_t lu_decompositions = 0;
+        std::size_t newton_iterations = 0;  // BDF only
+    };
+
+    // Tag: build df/dy by forward differences
+    struct finite_difference_jacobian {};
+
+    namespace detail {
+
+        template <std::size_t N, typename T>
+        using SVec = mathlib::linalg::Vector<N, T>;
+        template <std::size_t N, typename T>
+        using SMat = mathlib::linalg::Matrix<N, N, T>;
+
+        template <typename F, typename J, std::size_t N, typename T>
+        struct StiffSystem {
+            F& f;
+            J& jac;
+            const StiffOptions<T>& opt;
+            StiffStats& st;
+
+            SVec<N, T> rhs(T t, const SVec<N, T>& y) {
+                ++st.f_evals;
+                return f(t, y);
+            }
+
+            SMat<N, T> jacobian(T t, const SVec<N, T>& y, const SVec<N, T>& fy) {
+                ++st.jacobian_evals;
+                if constexpr (std::is_same_v<std::remove_cv_t<J>, finite_difference_jacobian>) {
+                    auto fy_t = [&](const SVec<N, T>& v) { return rhs(t, v); };
+                    return mathlib::calculus::jacobian_forward_banded(fy_t, y, fy,
+                        opt.lower_bandwidth, opt.upper_bandwidth, opt.fd_step);
+                }
+                else {
+                    (void)fy;
+                    return jac(t, y);
+                }
+            }
+
+            // df/dt by a forward difference; zero (and free) if opt.autonomous
+            SVec<N, T> time_derivative(T t, const SVec<N, T>& y, const SVec<N, T>& fy) {
+                if (opt.autonomous) return SVec<N, T>{};
+                const T dt = std::sqrt(std::numeric_limits<T>::epsilon()) * std::max(std::abs(t), static_cast<T>(1));
+                return (rhs(t + dt, y) - fy) / dt;
+            }
+
+            // LU of I - c J; false if singular
+            bool factor(mathlib::linalg::LU<N, T>& lu, const SMat<N, T>& Jm, T c) {
+                ++st.lu_decompositions;
+                for (std::size_t i = 0; i < N; ++i)
+                    for (std::size_t j = 0; j < N; ++j)
+                        lu.lu(i, j) = (i == j ? static_cast<T>(1) : T{}) - c * Jm(i, j);
+                return mathlib::linalg::detail::lu_factor_inplace(lu, std::numeric_limits<T>::min());
+            }
+
+            T norm(const SVec<N, T>& e, const SVec<N, T>& y0, const SVec<N, T>& y1) const {
+                T s{};
+                for (std::size_t i = 0; i < N; ++i) {
+                    const T sc = opt.atol + opt.rtol * std::max(std::abs(y0[i]), std::abs(y1[i]));
+                    const T r = e[i] / sc;
+                    s += r * r;
+                }
+                return std::sqrt(s / static_cast<T>(N));
+            }
+
+            T initial_step(T t0, const SVec<N, T>& y0, const SVec<N, T>& f0, T t1) const {
+                if (opt.h0 > T{}) return std::clamp(opt.h0, opt.h_min, opt.h_max);
+                const T d0 = norm(y0, y0, y0);
+                const T d1 = norm(f0, y0, y0);
+                T h = (d0 < static_cast<T>(1e-5) || d1 < static_cast<T>(1e-5))
+                    ? static_cast<T>(1e-6) : static_cast<T>(0.01) * d0 / d1;
+                h = std::min({ h, opt.h_max, t1 - t0 });
+                return std::max(h, opt.h_min);
+            }
+
+            void check(const char* who, T t0, T t1) const {
+                if (opt.rtol < T{} || opt.atol < T{} || (opt.rtol == T{} && opt.atol == T{})) {
+                    MATHLIB_THROW(mathlib::core::domain_error(std::string(who) + ": need rtol >= 0, atol >= 0, not both zero"));
+                }
+                if (t1 < t0) MATHLIB_THROW(mathlib::core::domain_error(std::string(who) + ": t1 must be >= t0"));
+            }
+        };
+
+        // Lagrange interpolant through (x[0..n-1], y[0..n-1]) evaluated at t
+        template <std::size_t N, typename T, std::size_t H>
+        SVec<N, T> lagrange_eval(const std::array<T, H>& x, const std::array<SVec<N, T>, H>& y,
+            std::size_t first, std::size_t n, T t) {
+            SVec<N, T> out{};
+            for (std::size_t m = first; m < first + n; ++m) {
+                T w = static_cast<T>(1);
+                for (std::size_t i = first; i < first + n; ++i) {
+                    if (i != m) w *= (t - x[i]) / (x[m] - x[i]);
+                }
+                out = out + w * y[m];
+            }
+            return out;
+        }
+
+        // Rosenbrock 2(3) of Shampine & Reichelt (MATLAB ode23s): L-stable,
+        // one LU of W = I - h d J per attempted step, FSAL on f. J and df/dt
+        // are evaluated once per accepted step and reused by rejected attempts.
+        template <typename F, typename J, std::size_t N, typename T, typename Obs>
+        std::pair<T, SVec<N, T>> rosenbrock23(F& f, J& jac, T t0, SVec<N, T> y0, T t1,
+            const StiffOptions<T>& opt, Obs& obs, StiffStats* stats) {
+            StiffStats st;
+            StiffSystem<F, J, N, T> sys{ f, jac, opt, st };
+            sys.check("solve_rosenbrock23()", t0, t1);
+
+            const T d = static_cast<T>(1) / (static_cast<T>(2) + std::sqrt(static_cast<T>(2)));
+            const T e32 = static_cast<T>(6) + std::sqrt(static_cast<T>(2));
+
+            T t = t0;
+            SVec<N, T> y = y0;
+            SVec<N, T> F0 = sys.rhs(t, y);
+            T h = sys.initial_step(t, y, F0, t1);
+            SMat<N, T> Jm = sys.jacobian(t, y, F0);
+            SVec<N, T> Tt = sys.time_derivative(t, y, F0);
+            mathlib::linalg::LU<N, T> W;
+            bool rejected = false;
+
+            if (!detail::notify(obs, t, y)) t1 = t;
+
+            while (t < t1) {
+                if (st.accepted + st.rejected >= opt.max_steps) MATHLIB_THROW(mathlib::core::domain_error("solve_rosenbrock23(): too many steps"));
+                if (h < opt.h_min) MATHLIB_THROW(mathlib::core::domain_error("solve_rosenbrock23(): step underflow (h < h_min)"));
+
+                const bool last = t + h >= t1;
+                const T hs = last ? t1 - t : h;
+
+                if (!sys.factor(W, Jm, hs * d)) {
+                    ++st.rejected;
+                    h = hs / static_cast<T>(2);
+                    continue;
+                }
+
+                const SVec<N, T> k1 = mathlib::linalg::lu_solve(W, F0 + (hs * d) * Tt);
+                const SVec<N, T> F1 = sys.rhs(t + hs / static_cast<T>(2), y + (hs / static_cast<T>(2)) * k1);
+                const SVec<N, T> k2 = mathlib::linalg::lu_solve(W, F1 - k1) + k1;
+                const SVec<N, T> ynew = y + hs * k2;
+                const SVec<N, T> F2 = sys.rhs(t + hs, ynew);
+                const SVec<N, T> k3 = mathlib::linalg::lu_solve(W,
+                    F2 - e32 * (k2 - F1) - static_cast<T>(2) * (k1 - F0) + (hs * d) * Tt);
+
+                const SVec<N, T> err = (hs / static_cast<T>(6)) * (k1 - static_cast<T>(2) * k2 + k3);
+                const T e = sys.norm(err, y, ynew);
+                const T fac = static_cast<T>(0.8) * std::pow(std::max(e, std::numeric_limits<T>::min()), static_cast<T>(-1) / static_cast<T>(3));
+
+                if (e <= static_cast<T>(1)) {
+                    t = last ? t1 : t + hs;
+                    y = ynew;
+                    F0 = F2;
+                    ++st.accepted;
+                    T h_new = hs * std::min(static_cast<T>(5), fac);
+                    if (rejected) h_new = std::min(h_new, hs);
+                    h = std::min(last ? std::max(h_new, h) : h_new, opt.h_max);
+                    rejected = false;
+                    if (!detail::notify(obs, t, y)) break;
+                    if (t < t1) {
+                        Jm = sys.jacobian(t, y, F0);
+                        Tt = sys.time_derivative(t, y, F0);
+                    }
+                }
+                else {
+                    ++st.rejected;
+                    rejected = true;
+                    h = hs * std::max(static_cast<T>(0.2), fac);
+                }
+            }
+            if (stats) *stats = st;
+            return { t, y };
+        }
+
+        // Variable-order (1..5), variable-step BDF in Lagrange form. The
+        // coefficients are recomputed from the actual past time points, so step
+        // changes need no history interpolation. The corrector is solved by
+        // simplified Newton with the factored iteration matrix I - gamma J kept
+        // across steps: it is refactored only when gamma drifts by more than 30%,
+        // and J is re-evaluated only when Newton fails to converge (or after 50 steps).
+        template <typename F, typename J, std::size_t N, typename T, typename Obs>
+        std::pair<T, SVec<N, T>> bdf(F& f, J& jac, T t0, SVec<N, T> y0, T t1,
+            const StiffOptions<T>& opt, Obs& obs, StiffStats* stats) {
+            StiffStats st;
+            StiffSystem<F, J, N, T> sys{ f, jac, opt, st };
+            sys.check("solve_bdf()", t0, t1);
+            if (opt.max_order < 1 || opt.max_order > 5) MATHLIB_THROW(mathlib::core::domain_error("solve_bdf(): max_order must be in 1..5"));
+
+            constexpr std::size_t H = 7;         // history capacity: k + 2 points for k <= 5
+            std::array<T, H> ts{};
+            std::array<SVec<N, T>, H> ys{};
+            std::size_t hn = 1;
+            ts[0] = t0;
+            ys[0] = y0;
+
+            T t = t0;
+            SVec<N, T> y = y0;
+            const SVec<N, T> f0 = sys.rhs(t, y);
+            T h = sys.initial_step(t, y, f0, t1);
+            if (opt.h0 <= T{}) h = std::max(h * static_cast<T>(0.1), opt.h_min); // first step is BDF1
+
+            SMat<N, T> Jm = sys.jacobian(t, y, f0);
+            bool j_fresh = true;
+            std::size_t j_age = 0;
+            mathlib::linalg::LU<N, T> M;
+            T gamma_m{};                          // gamma the current LU was built with (0 = none)
+            T crate = static_cast<T>(1);          // Newton convergence rate estimate
+            const T newton_tol = static_cast<T>(0.1);
+
+            std::size_t k = 1;
+            std::size_t steps_at_order = 0;
+            std::size_t fails = 0;
+
+            if (!detail::notify(obs, t, y)) t1 = t;
+
+            while (t < t1) {
+                if (st.accepted + st.rejected >= opt.max_steps) MATHLIB_THROW(mathlib::core::domain_error("solve_bdf(): too many steps"));
+                if (h < opt.h_min) MATHLIB_THROW(mathlib::core::domain_error("solve_bdf(): step underflow (h < h_min)"));
+
+                const bool last = t + h >= t1;
+                const T hs = last ? t1 - t : h;
+                const T tn1 = t + hs;
+
+                // a_j = l_j'(tn1) over nodes tn1, ts[0..k-1]
+                std::array<T, H> a{};
+                for (std::size_t m = 0; m < k; ++m) a[0] += static_cast<T>(1) / (tn1 - ts[m]);
+                for (std::size_t j = 1; j <= k; ++j) {
+                    const T xj = ts[j - 1];
+                    T num = static_cast<T>(1), den = xj - tn1;
+                    for (std::size_t m = 0; m < k; ++m) {
+                        if (m == j - 1) continue;
+                        num *= tn1 - ts[m];
+                        den *= xj - ts[m];
+                    }
+                    a[j] = num / den;
+                }
+                const T gamma = static_cast<T>(1) / a[0];
+                SVec<N, T> psi{};
+                for (std::size_t j = 1; j <= k; ++j) psi = psi - (gamma * a[j]) * ys[j - 1];
+
+                // Predictor of degree k and the matching error constant
+                SVec<N, T> yp;
+                T err_coef;
+                if (hn >= k + 1) {
+                    yp = lagrange_eval(ts, ys, 0, k + 1, tn1);
+                    err_coef = hs / (tn1 - ts[k]);
+                }
+                else {
+                    yp = y + hs * f0; // very first step: explicit Euler
+                    err_coef = static_cast<T>(1) / static_cast<T>(2);
+                }
+
+                if (gamma_m == T{} || std::abs(gamma / gamma_m - static_cast<T>(1)) > static_cast<T>(0.3)) {
+                    if (!sys.factor(M, Jm, gamma)) {
+                        ++st.rejected;
+                        h = hs / static_cast<T>(4);
+                        gamma_m = T{};
+                        continue;
+                    }
+                    gamma_m = gamma;
+                    crate = static_cast<T>(1);
+                }
+
+                // Simplified Newton on  y - gamma f(tn1, y) - psi = 0
+                SVec<N, T> yn = yp;
+                bool converged = false;
+                T d_prev{};
+                const T scale = static_cast<T>(2) / (static_cast<T>(1) + gamma / gamma_m);
+                for (std::size_t m = 0; m < 4; ++m) {
+                    const SVec<N, T> G = yn - gamma * sys.rhs(tn1, yn) - psi;
+                    const SVec<N, T> delta = scale * mathlib::linalg::lu_solve(M, static_cast<T>(-1) * G);
+                    yn = yn + delta;
+                    ++st.newton_iterations;
+                    const T dn = sys.norm(delta, y, yn);
+                    if (m > 0) {
+                        const T rate = dn / d_prev;
+                        if (rate > static_cast<T>(0.9)) break;
+                        crate = std::max(static_cast<T>(0.3) * crate, rate);
+                    }
+                    if (dn * std::min(static_cast<T>(1), crate) <= newton_tol || dn == T{}) {
+                        converged = true;
+                        break;
+                    }
+                    d_prev = dn;
+                }
+
+                if (!converged) {
+                    ++st.rejected;
+                    if (!j_fresh) {
+                        // Stale Jacobian: refresh it and retry the same step
+                        Jm = sys.jacobian(t, y, sys.rhs(t, y));
+                        j_fresh = true;
+                        j_age = 0;
+                    }
+                    else {
+                        h = hs / static_cast<T>(4);
+                    }
+                    gamma_m = T{};
+                    continue;
+                }
+
+                const T e = sys.norm(err_coef * (yn - yp), y, yn);
+                if (e > static_cast<T>(1)) {
+                    ++st.rejected;
+                    ++fails;
+                    if (fails >= 2 && k > 1) {
+                        --k;
+                        steps_at_order = 0;
+                    }
+                    h = hs * std::clamp(static_cast<T>(0.9) * std::pow(e, static_cast<T>(-1) / static_cast<T>(k + 1)),
+                        static_cast<T>(0.1), static_cast<T>(0.9));
+                    continue;
+                }
+
+                // Accept: shift the history
+                fails = 0;
+                for (std::size_t i = H - 1; i > 0; --i) {
+                    ts[i] = ts[i - 1];
+                    ys[i] = ys[i - 1];
+                }
+                ts[0] = tn1;
+                ys[0] = yn;
+                hn = std::min(hn + 1, H);
+                t = last ? t1 : tn1;
+                y = yn;
+                ++st.accepted;
+                ++steps_at_order;
+                j_fresh = false;
+
+                if (!detail::notify(obs, t, y)) break;
+                if (t >= t1) break;
+
+                // Order and step selection from Milne estimates at orders k-1, k, k+1
+                T best_r = std::pow(static_cast<T>(1) / (static_cast<T>(1.2) * std::max(e, static_cast<T>(1e-10))),
+                    static_cast<T>(1) / static_cast<T>(k + 1));
+                std::size_t best_q = k;
+                if (steps_at_order >= k + 1) {
+                    if (k > 1) {
+                        const SVec<N, T> p = lagrange_eval(ts, ys, 1, k, tn1);
+                        const T eq = sys.norm((hs / (tn1 - ts[k])) * (yn - p), y, yn);
+                        const T r = std::pow(static_cast<T>(1) / (static_cast<T>(1.3) * std::max(eq, static_cast<T>(1e-10))),
+                            static_cast<T>(1) / static_cast<T>(k));
+                        if (r > best_r) { best_r = r; best_q = k - 1; }
+                    }
+                    if (k < opt.max_order && hn >= k + 3) {
+                        const SVec<N, T> p = lagrange_eval(ts, ys, 1, k + 2, tn1);
+                        const T eq = sys.norm((hs / (tn1 - ts[k + 2])) * (yn - p), y, yn);
+                        const T r = std::pow(static_cast<T>(1) / (static_cast<T>(1.4) * std::max(eq, static_cast<T>(1e-10))),
+                            static_cast<T>(1) / static_cast<T>(k + 2));
+                        if (r > best_r) { best_r = r; best_q = k + 1; }
+                    }
+                }
+                if (best_q != k) {
+                    k = best_q;
+                    steps_at_order = 0;
+                }
+
+                // Keep h (and the LU) unless a change is worthwhile
+                const T r = std::min(best_r, static_cast<T>(2));
+                if (r >= static_cast<T>(1.2) || r < static_cast<T>(1)) h = std::min(hs * std::max(r, static_cast<T>(0.2)), opt.h_max);
+                else h = hs;
+
+                if (++j_age >= 50) {
+                    Jm = sys.jacobian(t, y, sys.rhs(t, y));
+                    j_fresh = true;
+                    j_age = 0;
+                    gamma_m = T{};
+                }
+            }
+            if (stats) *stats = st;
+            return { t, y };
+        }
+
+    } // namespace detail
+
+    // -----------------------
+    // Rosenbrock 2(3) (L-stable)
+    // -----------------------
+    template <typename F, typename J, std::size_t N, typename T, typename Obs>
+        requires observer<Obs, mathlib::linalg::Vector<N, T>, T>
+    std::pair<T, mathlib::linalg::Vector<N, T>> solve_rosenbrock23(F f, J jac, T t0,
+        mathlib::linalg::Vector<N, T> y0, T t1, const StiffOptions<T>& opt, Obs&& obs, StiffStats* stats = nullptr) {
+        return detail::rosenbrock23(f, jac, t0, std::move(y0), t1, opt, obs, stats);
+    }
+
+    template <typename F, typename J, std::size_t N, typename T>
+    Trajectory<mathlib::linalg::Vector<N, T>, T> solve_rosenbrock23(F f, J jac, T t0,
+        mathlib::linalg::Vector<N, T> y0, T t1, const StiffOptions<T>& opt = {}, StiffStats* stats = nullptr) {
+        Trajectory<mathlib::linalg::Vector<N, T>, T> out;
+        auto obs = [&out](const T& t, const mathlib::linalg::Vector<N, T>& y) { out.push_back({ t, y }); };
+        detail::rosenbrock23(f, jac, t0, std::move(y0), t1, opt, obs, stats);
+        return out;
+    }
+
+    // -----------------------
+    // BDF, orders 1..5
+    // -----------------------
+    template <typename F, typename J, std::size_t N, typename T, typename Obs>
+        requires observer<Obs, mathlib::linalg::Vector<N, T>, T>
+    std::pair<T, mathlib::linalg::Vector<N, T>> solve_bdf(F f, J jac, T t0,
+        mathlib::linalg::Vector<N, T> y0, T t1, const StiffOptions<T>& opt, Obs&& obs, StiffStats* stats = nullptr) {
+        return detail::bdf(f, jac, t0, std::move(y0), t1, opt, obs, stats);
+    }
+
+    template <typename F, typename J, std::size_t N, typename T>
+    Trajectory<mathlib::linalg::Vector<N, T>, T> solve_bdf(F f, J jac, T t0,
+        mathlib::linalg::Vector<N, T> y0, T t1, const StiffOptions<T>& opt = {}, StiffStats* stats = nullptr) {
+        Trajectory<mathlib::linalg::Vector<N, T>, T> out;
+        auto obs = [&out](const T& t, const mathlib::linalg::Vector<N, T>& y) { out.push_back({ t, y }); };
+        detail::bdf(f, jac, t0, std::move(y0), t1, opt, obs, stats);
+        return out;
+    }
+
+} // namespace mathlib::ode
@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/ode/observers.hpp"
+#include "mathlib/ode/state.hpp"
+
+namespace mathlib::ode {
+
+    // Phase-space point of a separable system q' = p, p' = a(q).
+    // Fold masses into the force callable (return accelerations).
+    template <typename State>
+    struct PhaseState {
+        State q;
+        State p;
+    };
+
+    // Kick-drift splitting with S drifts and S + 1 kicks:
+    //   p += kick[0] h a(q), q += drift[0] h p, p += kick[1] h a(q), ..., p += kick[S] h a(q)
+    // Zero kicks cost nothing. When kick[0] and kick[S] are both nonzero the last
+    // force of a step is reused as the first force of the next one.
+    template <typename T, std::size_t S>
+    struct SplittingMethod {
+        std::array<T, S + 1> kick{};
+        std::array<T, S> drift{};
+    };
+
+    struct SymplecticStats {
+        std::size_t steps = 0;
+        std::size_t force_evals = 0;
+    };
+
+    namespace detail {
+
+        // Symmetric composition of velocity Verlet substeps with weights w;
+        // adjacent half-kicks are merged.
+        template <typename T, std::size_t S>
+        constexpr SplittingMethod<T, S> compose_verlet(const std::array<T, S>& w) {
+            SplittingMethod<T, S> m;
+            m.kick[0] = w[0] / 2;
+            for (std::size_t i = 0; i < S; ++i) {
+                m.drift[i] = w[i];
+                m.kick[i + 1] = (w[i] + (i + 1 < S ? w[i + 1] : T{})) / 2;
+            }
+            return m;
+        }
+
+    } // namespace detail
+
+    // Velocity Verlet / kick-drift-kick leapfrog: 2nd order, 1 force per step.
+    template <typename T>
+    constexpr SplittingMethod<T, 1> velocity_verlet() {
+        return detail::compose_verlet<T, 1>({ T(1) });
+    }
+
+    // Yoshida triple jump: 4th order, 3 forces per step.
+    template <typename T>
+    constexpr SplittingMethod<T, 3> yoshida4() {
+        const T w1 = static_cast<T>(1.3512071919596576340476878089715);  // 1 / (2 - 2^(1/3))
+        const T w0 = static_cast<T>(-1.7024143839193152680953756179429); // 1 - 2 w1
+        return detail::compose_verlet<T, 3>({ w1, w0, w1 });
+    }
+
+    // Yoshida (1990) solution A: 6th order, 7 forces per step.
+    template <typename T>
+    constexpr SplittingMethod<T, 7> yoshida6() {
+        const T w1 = static_cast<T>(-1.17767998417887);
+        const T w2 = static_cast<T>(0.235573213359357);
+        const T w3 = static_cast<T>(0.784513610477560);
+        const T w0 = 1 - 2 * (w1 + w2 + w3);
+        return detail::compose_verlet<T, 7>({ w3, w2, w1, w0, w1, w2, w3 });
+    }
+
+    // Forest-Ruth (1990): 4th order in drift-first (position Verlet) form,
+    // 3 forces per step, no reuse.
+    template <typename T>
+    constexpr SplittingMethod<T, 4> forest_ruth() {
+        const T th = static_cast<T>(1.3512071919596576340476878089715);
+        SplittingMethod<T, 4> m;
+        m.kick = { T{}, th, 1 - 2 * th, th, T{} };
+        m.drift = { th / 2, (1 - th) / 2, (1 - th) / 2, th / 2 };
+        return m;
+    }
+
+    namespace detail {
+
+        template <typename State>
+        std::size_t extent(const State& s) {
+            if constexpr (requires { s.size(); }) return s.size();
+            else return state_traits<State>::size;
+        }
+
+        // y += c * x in place, componentwise (scalars, Vector, std::vector SoA, ...)
+        template <typename State, typename T>
+        void axpy_inplace(State& y, T c, const State& x) {
+            if constexpr (std::is_floating_point_v<State>) {
+                y += c * x;
+            }
+            else {
+                const std::size_t n = extent(y);
+                for (std::size_t i = 0; i < n; ++i) y[i] = y[i] + c * x[i];
+            }
+        }
+
+    } // namespace detail
+
+    // In-place stepper. The force is force(q, a) writing into a (no allocation),
+    // or a = force(q). The acceleration buffer is allocated once, here.
+    template <typename Force, typename State, typename T, std::size_t S>
+    class SymplecticStepper {
+    public:
+        SymplecticStepper(Force force, const SplittingMethod<T, S>& method, const State& like)
+            : force_(std::move(force)), m_(method), a_(like) {}
+
+        // Advance y by h in place.
+        void step(PhaseState<State>& y, T h) {
+            for (std::size_t i = 0; i < S; ++i) {
+                kick(y, m_.kick[i] * h, i == 0);
+                if (m_.drift[i] != T{}) {
+                    detail::axpy_inplace(y.q, m_.drift[i] * h, y.p);
+                    valid_ = false;
+                }
+            }
+            kick(y, m_.kick[S] * h, false);
+            ++stats_.steps;
+        }
+
+        // Call after modifying q outside the stepper.
+        void invalidate() { valid_ = false; }
+
+        const SymplecticStats& stats() const { return stats_; }
+
+    private:
+        void kick(PhaseState<State>& y, T c, bool first) {
+            if (c == T{}) return;
+            if (!(first && valid_)) {
+                if constexpr (std::is_invocable_v<Force&, const State&, State&>) {
+                    force_(y.q, a_);
+                }
+                else {
+                    a_ = force_(y.q);
+                }
+                ++stats_.force_evals;
+                valid_ = true;
+            }
+            detail::axpy_inplace(y.p, c, a_);
+        }
+
+        Force force_;
+        SplittingMethod<T, S> m_;
+        State a_;
+        bool valid_ = false;
+        SymplecticStats stats_{};
+    };
+
+    // Fixed-step symplectic integration of a separable system, streaming
+    // obs(t, y) with y a PhaseState; returns the final (t, y).
+    template <typename Force, typename State, typename T, std::size_t S, typename Obs>
+        requires observer<Obs, PhaseState<State>, T>
+    std::pair<T, PhaseState<State>> solve_symplectic(const SplittingMethod<T, S>& method, Force force,
+        T t0, PhaseState<State> y0, T t1, T h, Obs&& obs, SymplecticStats* stats = nullptr) {
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_symplectic(): h must be > 0"));
+        if (t1 < t0) MATHLIB_THROW(mathlib::core::domain_error("solve_symplectic(): t1 must be >= t0"));
+        if (detail::extent(y0.q) != detail::extent(y0.p)) {
+            MATHLIB_THROW(mathlib::core::dimension_error("solve_symplectic(): q and p sizes differ"));
+        }
+
+        SymplecticStepper<Force, State, T, S> stepper(std::move(force), method, y0.q);
+        T t = t0;
+        PhaseState<State> y = std::move(y0);
+        if (detail::notify(obs, t, y)) {
+            while (t < t1) {
+                const T step = std::min(h, t1 - t);
+                stepper.step(y, step);
+                t += step;
+                if (!detail::notify(obs, t, y)) break;
+            }
+        }
+        if (stats) *stats = stepper.stats();
+        return { t, std::move(y) };
+    }
+
+    template <typename Force, typename State, typename T, std::size_t S>
+    std::vector<std::pair<T, PhaseState<State>>> solve_symplectic(const SplittingMethod<T, S>& method,
+        Force force, T t0, PhaseState<State> y0, T t1, T h, SymplecticStats* stats = nullptr) {
+        if (h <= T{}) MATHLIB_THROW(mathlib::core::domain_error("solve_symplectic(): h must be > 0"));
+
+        std::vector<std::pair<T, PhaseState<State>>> out;
+        out.reserve(static_cast<std::size_t>(std::abs(t1 - t0) / h) + 2);
+        solve_symplectic(method, std::move(force), t0, std::move(y0), t1, h,
+            [&out](const T& t, const PhaseState<State>& y) { out.push_back({ t, y }); }, stats);
+        return out;
+    }
+
+} // namespace mathlib::ode
@@ -0,0 +1,387 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/core/mapped_file.hpp"
+#include "mathlib/ode/state.hpp"
+
+namespace mathlib::ode {
+
+    // Columnar trajectory file (little-endian):
+    //
+    //   header (64 bytes)  magic, version, dtype, dim, chunk capacity, flags
+    //   chunk 0..K-1       fixed size, 64-byte aligned:
+    //                        u64 count, padding to 64
+    //                        time column   [capacity]
+    //                        state columns [dim][capacity]
+    //                        per-component min[dim], max[dim]  (if indexed)
+    //
+    // Only the last chunk may be partially filled. The chunk count follows from
+    // the file size, so a file cut short by a crash stays readable up to its
+    // last complete chunk.
+    namespace detail {
+
+        inline constexpr char trajectory_magic[8] = { 'M', 'L', 'T', 'R', 'A', 'J', '\0', '\0' };
+        inline constexpr std::uint32_t trajectory_version = 1;
+        inline constexpr std::uint32_t trajectory_flag_index = 1u;
+        inline constexpr std::size_t trajectory_align = 64;
+
+        // Values are memcpy'd as stored; a big-endian port would need byte swaps.
+        static_assert(std::endian::native == std::endian::little,
+            "trajectory files are little-endian; this target is not");
+
+        struct TrajectoryHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t dtype;            // sizeof(T): 4 = float, 8 = double
+            std::uint64_t dim;
+            std::uint64_t chunk_capacity;
+            std::uint32_t flags;
+            std::uint32_t reserved0;
+            std::uint64_t chunk_bytes;
+            std::uint8_t reserved1[16];
+        };
+        static_assert(sizeof(TrajectoryHeader) == trajectory_align);
+
+        template <typename T>
+        constexpr std::uint32_t dtype_code() {
+            static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                "trajectory files store float or double");
+            return static_cast<std::uint32_t>(sizeof(T));
+        }
+
+        inline std::size_t align_up(std::size_t n) {
+            return (n + trajectory_align - 1) / trajectory_align * trajectory_align;
+        }
+
+        template <typename T>
+        std::size_t chunk_bytes(std::size_t dim, std::size_t capacity, bool indexed) {
+            std::size_t n = trajectory_align + (dim + 1) * capacity * sizeof(T);
+            if (indexed) n += 2 * dim * sizeof(T);
+            return align_up(n);
+        }
+
+    } // namespace detail
+
+    struct TrajectoryFileOptions {
+        std::size_t chunk_capacity = 4096; // samples per chunk
+        bool index = true;                 // store per-chunk min/max of each component
+    };
+
+    // Append-only writer usable directly as a solver observer: obs(t, y).
+    // Full chunks are handed to a background thread (double buffered), so
+    // the solver only blocks if the disk falls a whole chunk behind.
+    // Pass it by reference; it is not copyable.
+    template <typename State, typename T>
+    class TrajectoryWriter {
+    public:
+        using traits = state_traits<State>;
+        static constexpr std::size_t dim = traits::size;
+
+        explicit TrajectoryWriter(const std::string& path, const TrajectoryFileOptions& opt = {})
+            : cap_(opt.chunk_capacity), indexed_(opt.index),
+            bytes_(detail::chunk_bytes<T>(dim, opt.chunk_capacity, opt.index)),
+            active_(bytes_), pending_(bytes_) {
+            if (cap_ == 0) MATHLIB_THROW(mathlib::core::domain_error("TrajectoryWriter(): chunk_capacity must be > 0"));
+            file_ = std::fopen(path.c_str(), "wb");
+            if (!file_) MATHLIB_THROW(mathlib::core::io_error("TrajectoryWriter(): cannot create " + path));
+
+            detail::TrajectoryHeader h{};
+            std::memcpy(h.magic, detail::trajectory_magic, sizeof(h.magic));
+            h.version = detail::trajectory_version;
+            h.dtype = detail::dtype_code<T>();
+            h.dim = dim;
+            h.chunk_capacity = cap_;
+            h.flags = indexed_ ? detail::trajectory_flag_index : 0u;
+            h.chunk_bytes = bytes_;
+            if (std::fwrite(&h, sizeof(h), 1, file_) != 1) {
+                std::fclose(file_);
+                MATHLIB_THROW(mathlib::core::io_error("TrajectoryWriter(): cannot write header to " + path));
+            }
+
+            reset_active();
+            io_ = std::thread([this] { io_loop(); });
+        }
+
+        TrajectoryWriter(const TrajectoryWriter&) = delete;
+        TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+        // Errors are dropped here; call close() to observe them.
+        ~TrajectoryWriter() { finish(); }
+
+        void operator()(const T& t, const State& y) {
+            if (closed_) MATHLIB_THROW(mathlib::core::domain_error("TrajectoryWriter: write after close()"));
+            if (samples_ != 0 && t < last_t_) {
+                MATHLIB_THROW(mathlib::core::domain_error("TrajectoryWriter: times must be non-decreasing"));
+            }
+            last_t_ = t;
+
+            col(0)[count_] = t;
+            for (std::size_t c = 0; c < dim; ++c) {
+                const T v = traits::at(y, c);
+                col(c + 1)[count_] = v;
+                if (indexed_) {
+                    T* mn = index_ptr();
+                    mn[c] = std::min(mn[c], v);
+                    mn[dim + c] = std::max(mn[dim + c], v);
+                }
+            }
+            ++samples_;
+            if (++count_ == cap_ && !submit()) {
+                MATHLIB_THROW(mathlib::core::io_error("TrajectoryWriter: background write failed"));
+            }
+        }
+
+        // Writes the partial chunk, waits for the background writer and closes
+        // the file. Throws io_error if any write (including background ones) failed.
+        void close() {
+            if (!finish()) MATHLIB_THROW(mathlib::core::io_error("TrajectoryWriter::close(): write failed"));
+        }
+
+        std::size_t samples() const { return samples_; }
+
+    private:
+        // Flushes, joins the I/O thread and closes the file; false on any I/O error.
+        bool finish() noexcept {
+            if (closed_) return !failed_;
+            closed_ = true;
+            if (count_ > 0) submit();
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            io_.join();
+            if (std::fclose(file_) != 0) failed_ = true;
+            file_ = nullptr;
+            return !failed_;
+        }
+
+        T* col(std::size_t k) { return reinterpret_cast<T*>(active_.data() + detail::trajectory_align) + k * cap_; }
+        T* index_ptr() { return col(dim + 1); }
+
+        void reset_active() {
+            std::fill(active_.begin(), active_.end(), std::byte{ 0 });
+            count_ = 0;
+            if (indexed_) {
+                T* mn = index_ptr();
+                std::fill(mn, mn + dim, std::numeric_limits<T>::infinity());
+                std::fill(mn + dim, mn + 2 * dim, -std::numeric_limits<T>::infinity());
+            }
+        }
+
+        // Hands the active chunk to the I/O thread; false once a write has failed.
+        bool submit() noexcept {
+            const std::uint64_t n = count_;
+            std::memcpy(active_.data(), &n, sizeof(n));
+            bool ok;
+            {
+                std::unique_lock<std::mutex> lock(mu_);
+                cv_.wait(lock, [this] { return !has_pending_; });
+                std::swap(active_, pending_);
+                has_pending_ = true;
+                ok = !failed_;
+            }
+            cv_.notify_all();
+            reset_active();
+            return ok;
+        }
+
+        void io_loop() {
+            std::unique_lock<std::mutex> lock(mu_);
+            for (;;) {
+                cv_.wait(lock, [this] { return has_pending_ || stop_; });
+                if (!has_pending_) return;
+                lock.unlock();
+                // pending_ is owned by this thread until has_pending_ is cleared
+                const bool ok = std::fwrite(pending_.data(), 1, bytes_, file_) == bytes_;
+                lock.lock();
+                if (!ok) failed_ = true;
+                has_pending_ = false;
+                cv_.notify_all();
+            }
+        }
+
+        std::size_t cap_;
+        bool indexed_;
+        std::size_t bytes_;
+        std::vector<std::byte> active_;
+        std::vector<std::byte> pending_;
+        std::size_t count_ = 0;
+        std::size_t samples_ = 0;
+        T last_t_{};
+        bool closed_ = false;
+
+        std::FILE* file_ = nullptr;
+        std::thread io_;
+        std::mutex mu_;
+        std::condition_variable cv_;
+        bool has_pending_ = false;
+        bool stop_ = false;
+        bool failed_ = false;
+    };
+
+    // Zero-copy view of one chunk.
+    template <typename T>
+    struct TrajectoryChunk {
+        std::span<const T> t;
+        const T* columns = nullptr; // [dim][capacity]
+        const T* bounds = nullptr;  // min[dim], max[dim], or null
+        std::size_t capacity = 0;
+        std::size_t dim = 0;
+
+        std::size_t size() const { return t.size(); }
+        std::span<const T> component(std::size_t c) const { return { columns + c * capacity, t.size() }; }
+        bool indexed() const { return bounds != nullptr; }
+        T min(std::size_t c) const { return bounds[c]; }
+        T max(std::size_t c) const { return bounds[dim + c]; }
+    };
+
+    // Memory-mapped reader. Nothing is copied until a sample is requested;
+    // chunks are located by binary search on their first/last times.
+    template <typename State, typename T>
+    class TrajectoryReader {
+    public:
+        using traits = state_traits<State>;
+        static constexpr std::size_t dim = traits::size;
+
+        explicit TrajectoryReader(const std::string& path) : file_(path) {
+            if (file_.size() < sizeof(detail::TrajectoryHeader)) {
+                MATHLIB_THROW(mathlib::core::io_error("TrajectoryReader(): " + path + " is too small"));
+            }
+            detail::TrajectoryHeader h;
+            std::memcpy(&h, file_.data(), sizeof(h));
+            if (std::memcmp(h.magic, detail::trajectory_magic, sizeof(h.magic)) != 0) {
+                MATHLIB_THROW(mathlib::core::io_error("TrajectoryReader(): " + path + " is not a trajectory file"));
+            }
+            if (h.version != detail::trajectory_version) {
+                MATHLIB_THROW(mathlib::core::io_error("TrajectoryReader(): unsupported version in " + path));
+            }
+            if (h.dtype != detail::dtype_code<T>() || h.dim != dim) {
+                MATHLIB_THROW(mathlib::core::dimension_error("TrajectoryReader(): file schema does not match State/T"));
+            }
+            cap_ = static_cast<std::size_t>(h.chunk_capacity);
+            indexed_ = (h.flags & detail::trajectory_flag_index) != 0;
+            bytes_ = static_cast<std::size_t>(h.chunk_bytes);
+            if (cap_ == 0 || bytes_ != detail::chunk_bytes<T>(dim, cap_, indexed_)) {
+                MATHLIB_THROW(mathlib::core::io_error("TrajectoryReader(): corrupt header in " + path));
+            }
+
+            chunks_ = (file_.size() - sizeof(h)) / bytes_;
+            for (std::size_t k = 0; k < chunks_; ++k) {
+                const std::size_t n = chunk_count(k);
+                if (n == 0 || n > cap_ || (n < cap_ && k + 1 != chunks_)) {
+                    MATHLIB_THROW(mathlib::core::io_error("TrajectoryReader(): corrupt chunk in " + path));
+                }
+                size_ += n;
+            }
+            file_.advise(core::mapped_file::access::random);
+        }
+
+        std::size_t size() const { return size_; }
+        std::size_t chunks() const { return chunks_; }
+        std::size_t chunk_capacity() const { return cap_; }
+        bool indexed() const { return indexed_; }
+
+        TrajectoryChunk<T> chunk(std::size_t k) const {
+            if (k >= chunks_) MATHLIB_THROW(mathlib::core::domain_error("TrajectoryReader::chunk(): index out of range"));
+            const T* base = reinterpret_cast<const T*>(chunk_base(k) + detail::trajectory_align);
+            TrajectoryChunk<T> c;
+            c.t = { base, chunk_count(k) };
+            c.columns = base + cap_;
+            c.bounds = indexed_ ? base + (dim + 1) * cap_ : nullptr;
+            c.capacity = cap_;
+            c.dim = dim;
+            return c;
+        }
+
+        // Sample i (global index).
+        T time(std::size_t i) const {
+            check_sample(i, "TrajectoryReader::time()");
+            return chunk(i / cap_).t[i % cap_];
+        }
+
+        T component(std::size_t i, std::size_t c) const {
+            check_sample(i, "TrajectoryReader::component()");
+            if (c >= dim) MATHLIB_THROW(mathlib::core::domain_error("TrajectoryReader::component(): component out of range"));
+            return chunk(i / cap_).component(c)[i % cap_];
+        }
+
+        State state(std::size_t i) const {
+            check_sample(i, "TrajectoryReader::state()");
+            const auto ch = chunk(i / cap_);
+            State y{};
+            for (std::size_t c = 0; c < dim; ++c) traits::at(y, c) = ch.component(c)[i % cap_];
+            return y;
+        }
+
+        // Global index range [first, last) of samples with t0 <= t <= t1.
+        std::pair<std::size_t, std::size_t> window(T t0, T t1) const {
+            return { lower_index(t0), upper_index(t1) };
+        }
+
+    private:
+        void check_sample(std::size_t i, const char* who) const {
+            if (i >= size_) MATHLIB_THROW(mathlib::core::domain_error(std::string(who) + ": index out of range"));
+        }
+
+        const std::byte* chunk_base(std::size_t k) const {
+            return file_.data() + sizeof(detail::TrajectoryHeader) + k * bytes_;
+        }
+
+        std::size_t chunk_count(std::size_t k) const {
+            std::uint64_t n;
+            std::memcpy(&n, chunk_base(k), sizeof(n));
+            return static_cast<std::size_t>(n);
+        }
+
+        // first index with time >= t
+        std::size_t lower_index(T t) const {
+            std::size_t lo = 0, hi = chunks_;
+            while (lo < hi) { // first chunk whose last time >= t
+                const std::size_t mid = (lo + hi) / 2;
+                const auto c = chunk(mid);
+                if (c.t.back() < t) lo = mid + 1;
+                else hi = mid;
+            }
+            if (lo == chunks_) return size_;
+            const auto c = chunk(lo);
+            return lo * cap_ + static_cast<std::size_t>(std::lower_bound(c.t.begin(), c.t.end(), t) - c.t.begin());
+        }
+
+        // first index with time > t
+        std::size_t upper_index(T t) const {
+            std::size_t lo = 0, hi = chunks_;
+            while (lo < hi) { // first chunk whose last time > t
+                const std::size_t mid = (lo + hi) / 2;
+                const auto c = chunk(mid);
+                if (c.t.back() <= t) lo = mid + 1;
+                else hi = mid;
+            }
+            if (lo == chunks_) return size_;
+            const auto c = chunk(lo);
+            return lo * cap_ + static_cast<std::size_t>(std::upper_bound(c.t.begin(), c.t.end(), t) - c.t.begin());
+        }
+
+        core::mapped_file file_;
+        std::size_t cap_ = 0;
+        std::size_t bytes_ = 0;
+        bool indexed_ = false;
+        std::size_t chunks_ = 0;
+        std::size_t size_ = 0;
+    };
+
+} // namespace mathlib::ode
@@ -0,0 +1,471 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mathlib/linalg/vector.hpp"
+#include "mathlib/calculus/grad.hpp"
+#include "mathlib/core/error.hpp"
+
+namespace mathlib::optimize {
+
+    template <std::size_t N, typename T>
+    using Vec = mathlib::linalg::Vector<N, T>;
+
+    template <typename T>
+    struct MinimizeOptions {
+        std::size_t max_iter = 1000;
+        T grad_tol = static_cast<T>(1e-8);   // stop when max|projected gradient| <= grad_tol
+        T f_tol = static_cast<T>(1e-15);     // ... or when the relative decrease of f falls below f_tol
+        std::size_t memory = 8;              // L-BFGS history length m
+        T c1 = static_cast<T>(1e-4);         // sufficient decrease (Armijo)
+        T c2 = static_cast<T>(0.9);          // curvature condition; minimize_cg uses min(c2, 0.1)
+        std::size_t max_linesearch = 40;
+    };
+
+    // Box constraints; use +-infinity for unbounded components.
+    template <std::size_t N, typename T>
+    struct Bounds {
+        Vec<N, T> lower{};
+        Vec<N, T> upper{};
+    };
+
+    template <std::size_t N, typename T>
+    struct MinimizeResult {
+        Vec<N, T> x{};
+        T f{};
+        Vec<N, T> g{};
+        std::size_t iterations = 0;
+        std::size_t evaluations = 0;   // objective+gradient evaluations requested by the method
+        std::size_t f_evals = 0;       // scalar objective calls (includes finite-difference probes)
+        bool converged = false;
+    };
+
+    // -----------------------
+    // Gradient sources
+    // -----------------------
+    // An objective is a callable fg(x, g) -> f that fills g with the gradient at x.
+    // Objectives that count their own scalar calls expose a `f_calls` member.
+
+    // Gradient by central differences (2N + 1 calls of f per evaluation)
+    template <typename F, typename T>
+    struct FiniteDifferenceObjective {
+        F f;
+        T h;
+        std::size_t f_calls = 0;
+
+        template <std::size_t N>
+        T operator()(const Vec<N, T>& x, Vec<N, T>& g) {
+            auto counted = [this](const Vec<N, T>& v) { ++f_calls; return f(v); };
+            g = mathlib::calculus::gradient<decltype(counted), N, T>(counted, x, h);
+            ++f_calls;
+            return f(x);
+        }
+    };
+
+    template <typename F, typename T = double>
+    FiniteDifferenceObjective<F, T> finite_difference_objective(F f, T h = static_cast<T>(1e-6)) {
+        return { f, h };
+    }
+
+    // User-provided (analytic or AD) gradient: grad(x) -> Vector
+    template <typename F, typename G>
+    struct GradientObjective {
+        F f;
+        G grad;
+        std::size_t f_calls = 0;
+
+        template <std::size_t N, typename T>
+        T operator()(const Vec<N, T>& x, Vec<N, T>& g) {
+            g = grad(x);
+            ++f_calls;
+            return f(x);
+        }
+    };
+
+    template <typename F, typename G>
+    GradientObjective<F, G> gradient_objective(F f, G grad) {
+        return { f, grad };
+    }
+
+    namespace detail {
+
+        template <std::size_t N, typename T>
+        T max_abs(const Vec<N, T>& v) {
+            T m{};
+            for (std::size_t i = 0; i < N; ++i) m = std::max(m, std::abs(v[i]));
+            return m;
+        }
+
+        template <typename Obj, std::size_t N, typename T>
+        T evaluate(Obj& obj, const Vec<N, T>& x, Vec<N, T>& g, MinimizeResult<N, T>& res) {
+            ++res.evaluations;
+            return obj(x, g);
+        }
+
+        template <typename Obj, std::size_t N, typename T>
+        void finish(Obj& obj, MinimizeResult<N, T>& res) {
+            if constexpr (requires { obj.f_calls; }) res.f_evals = obj.f_calls;
+            else res.f_evals = res.evaluations;
+        }
+
+        // Minimizer of the cubic interpolating (a, fa, da) and (b, fb, db),
+        // safeguarded to the interior of [a, b]; falls back to bisection.
+        template <typename T>
+        T cubic_min(T a, T fa, T da, T b, T fb, T db) {
+            const T lo = std::min(a, b), hi = std::max(a, b);
+            const T margin = static_cast<T>(0.1) * (hi - lo);
+            const T d1 = da + db - static_cast<T>(3) * (fa - fb) / (a - b);
+            const T disc = d1 * d1 - da * db;
+            if (disc >= T{}) {
+                const T d2 = std::copysign(std::sqrt(disc), b - a);
+                const T den = db - da + static_cast<T>(2) * d2;
+                if (den != T{}) {
+                    const T t = b - (b - a) * (db + d2 - d1) / den;
+                    if (std::isfinite(t)) return std::clamp(t, lo + margin, hi - margin);
+                }
+            }
+            return (a + b) / static_cast<T>(2);
+        }
+
+        template <std::size_t N, typename T>
+        struct LineSearchPoint {
+            T alpha{};
+            T f{};
+            Vec<N, T> x{};
+            Vec<N, T> g{};
+            bool ok = false;
+        };
+
+        // Strong-Wolfe line search (Nocedal & Wright, Alg. 3.5/3.6) along d from x.
+        // Every trial evaluates f and g together; the accepted point's values are
+        // handed back so the caller never recomputes them.
+        template <typename Obj, std::size_t N, typename T>
+        LineSearchPoint<N, T> line_search_wolfe(Obj& obj, const Vec<N, T>& x, T f0, T dphi0,
+            const Vec<N, T>& d, T alpha0, T c1, T c2, std::size_t max_eval, MinimizeResult<N, T>& res) {
+            LineSearchPoint<N, T> cur, prev, best;
+            prev.alpha = T{};
+            prev.f = f0;
+            prev.x = x;
+            T dprev = dphi0;
+            best = prev;
+
+            auto eval = [&](T a, LineSearchPoint<N, T>& p) {
+                p.alpha = a;
+                p.x = x + a * d;
+                p.f = evaluate(obj, p.x, p.g, res);
+                if (p.f < best.f && p.f <= f0 + c1 * a * dphi0) {
+                    best = p;
+                    best.ok = true;
+                }
+                return dot(p.g, d);
+            };
+
+            auto zoom = [&](LineSearchPoint<N, T> lo, T dlo, LineSearchPoint<N, T> hi, T dhi, std::size_t left) {
+                while (left-- > 0) {
+                    const T a = cubic_min(lo.alpha, lo.f, dlo, hi.alpha, hi.f, dhi);
+                    LineSearchPoint<N, T> p;
+                    const T da = eval(a, p);
+                    if (p.f > f0 + c1 * a * dphi0 || p.f >= lo.f) {
+                        hi = p;
+                        dhi = da;
+                    }
+                    else {
+                        if (std::abs(da) <= -c2 * dphi0) {
+                            p.ok = true;
+                            return p;
+                        }
+                        if (da * (hi.alpha - lo.alpha) >= T{}) {
+                            hi = lo;
+                            dhi = dlo;
+                        }
+                        lo = p;
+                        dlo = da;
+                    }
+                    if (std::abs(hi.alpha - lo.alpha) <= std::numeric_limits<T>::epsilon() * std::abs(lo.alpha)) break;
+                }
+                return best; // sufficient decrease only (or !ok)
+            };
+
+            T a = alpha0;
+            for (std::size_t i = 0; i < max_eval; ++i) {
+                const T da = eval(a, cur);
+                const std::size_t left = max_eval - i - 1;
+                if (cur.f > f0 + c1 * a * dphi0 || (i > 0 && cur.f >= prev.f)) {
+                    return zoom(prev, dprev, cur, da, left);
+                }
+                if (std::abs(da) <= -c2 * dphi0) {
+                    cur.ok = true;
+                    return cur;
+                }
+                if (da >= T{}) {
+                    return zoom(cur, da, prev, dprev, left);
+                }
+                prev = cur;
+                dprev = da;
+                a *= static_cast<T>(2);
+            }
+            return best;
+        }
+
+        template <std::size_t N, typename T>
+        Vec<N, T> project(Vec<N, T> x, const Bounds<N, T>& b) {
+            for (std::size_t i = 0; i < N; ++i) x[i] = std::clamp(x[i], b.lower[i], b.upper[i]);
+            return x;
+        }
+
+        // Components of g that would move x out of the box are zeroed.
+        template <std::size_t N, typename T>
+        Vec<N, T> projected_gradient(const Vec<N, T>& x, const Vec<N, T>& g, const Bounds<N, T>& b) {
+            Vec<N, T> pg = g;
+            for (std::size_t i = 0; i < N; ++i) {
+                if ((x[i] <= b.lower[i] && g[i] > T{}) || (x[i] >= b.upper[i] && g[i] < T{})) pg[i] = T{};
+            }
+            return pg;
+        }
+
+        // L-BFGS history: at most m pairs (s, y), O(mN) storage.
+        template <std::size_t N, typename T>
+        struct LbfgsHistory {
+            std::vector<Vec<N, T>> s, y;
+            std::vector<T> rho, alpha;
+            std::size_t m = 0, head = 0, count = 0;
+
+            explicit LbfgsHistory(std::size_t mem) : s(mem), y(mem), rho(mem), alpha(mem), m(mem) {}
+
+            void clear() { head = count = 0; }
+
+            void push(const Vec<N, T>& sk, const Vec<N, T>& yk) {
+                const T sy = dot(sk, yk);
+                // Skip pairs that would break positive definiteness
+                if (!(sy > std::numeric_limits<T>::epsilon() * dot(yk, yk))) return;
+                s[head] = sk;
+                y[head] = yk;
+                rho[head] = static_cast<T>(1) / sy;
+                head = (head + 1) % m;
+                count = std::min(count + 1, m);
+            }
+
+            // Two-loop recursion: returns -H g
+            Vec<N, T> direction(const Vec<N, T>& g) {
+                Vec<N, T> q = g;
+                T* al = alpha.data();
+                for (std::size_t k = 0; k < count; ++k) {
+                    const std::size_t i = (head + m - 1 - k) % m;
+                    al[k] = rho[i] * dot(s[i], q);
+                    q = q - al[k] * y[i];
+                }
+                if (count > 0) {
+                    const std::size_t i = (head + m - 1) % m;
+                    q = q * (dot(s[i], y[i]) / dot(y[i], y[i]));
+                }
+                for (std::size_t k = count; k-- > 0;) {
+                    const std::size_t i = (head + m - 1 - k) % m;
+                    const T beta = rho[i] * dot(y[i], q);
+                    q = q + (al[k] - beta) * s[i];
+                }
+                return static_cast<T>(-1) * q;
+            }
+        };
+
+        template <typename T>
+        bool small_decrease(T f_prev, T f, T tol) {
+            return (f_prev - f) <= tol * std::max({ std::abs(f_prev), std::abs(f), static_cast<T>(1) });
+        }
+
+        template <typename T>
+        void check_options(const MinimizeOptions<T>& opt, const char* who) {
+            if (opt.grad_tol <= T{}) MATHLIB_THROW(core::domain_error(std::string(who) + ": grad_tol must be > 0"));
+            if (!(opt.c1 > T{} && opt.c1 < opt.c2 && opt.c2 < static_cast<T>(1))) {
+                MATHLIB_THROW(core::domain_error(std::string(who) + ": need 0 < c1 < c2 < 1"));
+            }
+        }
+
+    } // namespace detail
+
+    // L-BFGS with strong-Wolfe line search (unconstrained).
+    template <typename Obj, std::size_t N, typename T>
+    MinimizeResult<N, T> minimize_lbfgs(Obj&& obj, const Vec<N, T>& x0,
+        const MinimizeOptions<T>& opt = {}) {
+        static_assert(std::is_floating_point_v<T>, "minimize_lbfgs: T must be floating point");
+        detail::check_options(opt, "minimize_lbfgs()");
+        if (opt.memory == 0) MATHLIB_THROW(core::domain_error("minimize_lbfgs(): memory must be > 0"));
+
+        MinimizeResult<N, T> res;
+        res.x = x0;
+        res.f = detail::evaluate(obj, res.x, res.g, res);
+        detail::LbfgsHistory<N, T> hist(opt.memory);
+
+        for (; res.iterations < opt.max_iter; ++res.iterations) {
+            if (detail::max_abs(res.g) <= opt.grad_tol) {
+                res.converged = true;
+                break;
+            }
+
+            Vec<N, T> d = hist.direction(res.g);
+            T dphi0 = dot(res.g, d);
+            if (!(dphi0 < T{})) {
+                hist.clear();
+                d = static_cast<T>(-1) * res.g;
+                dphi0 = dot(res.g, d);
+            }
+            const T alpha0 = (hist.count == 0)
+                ? std::min(static_cast<T>(1), static_cast<T>(1) / std::sqrt(dot(res.g, res.g)))
+                : static_cast<T>(1);
+
+            auto p = detail::line_search_wolfe(obj, res.x, res.f, dphi0, d, alpha0,
+                opt.c1, opt.c2, opt.max_linesearch, res);
+            if (!p.ok) break;
+
+            hist.push(p.x - res.x, p.g - res.g);
+            const T f_prev = res.f;
+            res.x = p.x;
+            res.f = p.f;
+            res.g = p.g;
+
+            if (detail::small_decrease(f_prev, res.f, opt.f_tol)) {
+                res.converged = true;
+                ++res.iterations;
+                break;
+            }
+        }
+        detail::finish(obj, res);
+        return res;
+    }
+
+    // L-BFGS-B style bound-constrained variant: variables pinned at a bound with the
+    // gradient pointing outward are frozen, the L-BFGS direction is built on the free
+    // set, and a projected backtracking (Armijo) search keeps iterates feasible.
+    template <typename Obj, std::size_t N, typename T>
+    MinimizeResult<N, T> minimize_lbfgs(Obj&& obj, const Vec<N, T>& x0, const Bounds<N, T>& bounds,
+        const MinimizeOptions<T>& opt = {}) {
+        static_assert(std::is_floating_point_v<T>, "minimize_lbfgs: T must be floating point");
+        detail::check_options(opt, "minimize_lbfgs()");
+        if (opt.memory == 0) MATHLIB_THROW(core::domain_error("minimize_lbfgs(): memory must be > 0"));
+        for (std::size_t i = 0; i < N; ++i) {
+            if (bounds.lower[i] > bounds.upper[i]) MATHLIB_THROW(core::domain_error("minimize_lbfgs(): lower > upper"));
+        }
+
+        MinimizeResult<N, T> res;
+        res.x = detail::project(x0, bounds);
+        res.f = detail::evaluate(obj, res.x, res.g, res);
+        detail::LbfgsHistory<N, T> hist(opt.memory);
+
+        for (; res.iterations < opt.max_iter; ++res.iterations) {
+            const Vec<N, T> pg = detail::projected_gradient(res.x, res.g, bounds);
+            if (detail::max_abs(pg) <= opt.grad_tol) {
+                res.converged = true;
+                break;
+            }
+
+            Vec<N, T> d = hist.direction(pg);
+            for (std::size_t i = 0; i < N; ++i) {
+                if (pg[i] == T{} && res.g[i] != T{}) d[i] = T{}; // active bound
+            }
+            if (!(dot(pg, d) < T{})) {
+                hist.clear();
+                d = static_cast<T>(-1) * pg;
+            }
+
+            T alpha = (hist.count == 0)
+                ? std::min(static_cast<T>(1), static_cast<T>(1) / std::sqrt(dot(pg, pg)))
+                : static_cast<T>(1);
+            bool ok = false;
+            Vec<N, T> xn, gn;
+            T fn{};
+            for (std::size_t ls = 0; ls < opt.max_linesearch; ++ls) {
+                xn = detail::project(res.x + alpha * d, bounds);
+                fn = detail::evaluate(obj, xn, gn, res);
+                if (fn <= res.f + opt.c1 * dot(res.g, xn - res.x)) {
+                    ok = true;
+                    break;
+                }
+                alpha /= static_cast<T>(2);
+            }
+            if (!ok) break;
+
+            hist.push(xn - res.x, gn - res.g);
+            const T f_prev = res.f;
+            res.x = xn;
+            res.f = fn;
+            res.g = gn;
+
+            if (detail::small_decrease(f_prev, res.f, opt.f_tol)) {
+                res.converged = true;
+                ++res.iterations;
+                break;
+            }
+        }
+        detail::finish(obj, res);
+        return res;
+    }
+
+    // Nonlinear conjugate gradient (Polak-Ribiere+, restart on loss of descent
+    // and every N iterations) with strong-Wolfe line search.
+    template <typename Obj, std::size_t N, typename T>
+    MinimizeResult<N, T> minimize_cg(Obj&& obj, const Vec<N, T>& x0,
+        const MinimizeOptions<T>& opt = {}) {
+        static_assert(std::is_floating_point_v<T>, "minimize_cg: T must be floating point");
+        detail::check_options(opt, "minimize_cg()");
+        const T c2 = std::min(opt.c2, static_cast<T>(0.1));
+
+        MinimizeResult<N, T> res;
+        res.x = x0;
+        res.f = detail::evaluate(obj, res.x, res.g, res);
+
+        Vec<N, T> d = static_cast<T>(-1) * res.g;
+        T alpha_prev{}, dphi_prev{};
+
+        for (; res.iterations < opt.max_iter; ++res.iterations) {
+            if (detail::max_abs(res.g) <= opt.grad_tol) {
+                res.converged = true;
+                break;
+            }
+
+            T dphi0 = dot(res.g, d);
+            if (!(dphi0 < T{})) {
+                d = static_cast<T>(-1) * res.g;
+                dphi0 = dot(res.g, d);
+            }
+            // Reuse the previous step's first-order change as the initial guess
+            const T alpha0 = (res.iterations == 0)
+                ? std::min(static_cast<T>(1), static_cast<T>(1) / std::sqrt(dot(res.g, res.g)))
+                : std::min(static_cast<T>(1), static_cast<T>(1.01) * alpha_prev * dphi_prev / dphi0);
+
+            auto p = detail::line_search_wolfe(obj, res.x, res.f, dphi0, d, alpha0,
+                opt.c1, c2, opt.max_linesearch, res);
+            if (!p.ok) break;
+
+            const T gg = dot(res.g, res.g);
+            T beta = dot(p.g, p.g - res.g) / gg;
+            if (beta < T{} || (res.iterations + 1) % N == 0) beta = T{};
+
+            const T f_prev = res.f;
+            alpha_prev = p.alpha;
+            dphi_prev = dphi0;
+            res.x = p.x;
+            res.f = p.f;
+            res.g = p.g;
+            d = static_cast<T>(-1) * res.g + beta * d;
+
+            if (detail::small_decrease(f_prev, res.f, opt.f_tol)) {
+                res.converged = true;
+                ++res.iterations;
+                break;
+            }
+        }
+        detail::finish(obj, res);
+        return res;
+    }
+
+    // Convenience: L-BFGS on f(x) with a finite-difference gradient.
+    template <typename F, std::size_t N, typename T>
+    MinimizeResult<N, T> minimize(F f, const Vec<N, T>& x0, const MinimizeOptions<T>& opt = {}) {
+        return minimize_lbfgs(finite_difference_objective<F, T>(f), x0, opt);
+    }
+
+} // namespace mathlib::optimize
@@ -0,0 +1,170 @@
+#include "mathlib/kernels/kernels.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "table.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#define MATHLIB_CPUID_MSVC 1
+#endif
+
+namespace mathlib::kernels {
+
+    namespace {
+
+        constexpr isa all_isas[] = { isa::scalar, isa::sse2, isa::avx2, isa::avx512 };
+
+#if defined(MATHLIB_CPUID_MSVC)
+        // cpuid leaf 1 / leaf 7 bits plus the OS check (XCR0) that the
+        // wider registers are saved on context switch
+        bool msvc_has(isa i) noexcept {
+            int r1[4], r7[4];
+            __cpuid(r1, 1);
+            __cpuidex(r7, 7, 0);
+            const bool sse2 = (r1[3] >> 26) & 1;
+            const bool osxsave = (r1[2] >> 27) & 1;
+            const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            const bool avx_os = (xcr0 & 0x6) == 0x6;
+            const bool avx512_os = (xcr0 & 0xE6) == 0xE6;
+            const bool fma = (r1[2] >> 12) & 1;
+            const bool avx2 = (r7[1] >> 5) & 1;
+            const bool avx512 = ((r7[1] >> 16) & 1) && ((r7[1] >> 17) & 1) && ((r7[1] >> 30) & 1) && ((r7[1] >> 31) & 1);
+            switch (i) {
+            case isa::sse2: return sse2;
+            case isa::avx2: return avx_os && avx2 && fma;
+            case isa::avx512: return avx512_os && avx512;
+            default: return true;
+            }
+        }
+#endif
+
+        bool cpu_has(isa i) noexcept {
+            if (i == isa::scalar) return true;
+#if defined(MATHLIB_CPUID_MSVC)
+            return msvc_has(i);
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+            switch (i) {
+            case isa::sse2: return __builtin_cpu_supports("sse2");
+            case isa::avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            case isa::avx512:
+                return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                    __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw");
+            default: return false;
+            }
+#else
+            return false;
+#endif
+        }
+
+        // table compiled for i, or null if this build has none
+        const detail::kernel_table* compiled_table(isa i) noexcept {
+            switch (i) {
+            case isa::scalar: return &detail::scalar::table;
+#if MATHLIB_KERNELS_X86
+            case isa::sse2: return &detail::sse2::table;
+            case isa::avx2: return &detail::avx2::table;
+            case isa::avx512: return &detail::avx512::table;
+#endif
+            default: return nullptr;
+            }
+        }
+
+        bool usable(isa i) noexcept {
+            return compiled_table(i) != nullptr && cpu_has(i);
+        }
+
+        isa detect() noexcept {
+            isa best = isa::scalar;
+            for (isa i : all_isas) {
+                if (usable(i)) best = i;
+            }
+            return best;
+        }
+
+        // detected_isa(), or the MATHLIB_ISA request lowered to the nearest
+        // usable set
+        isa initial_isa() noexcept {
+            const char* env = std::getenv("MATHLIB_ISA");
+            if (env == nullptr) return detected_isa();
+            for (isa i : all_isas) {
+                if (std::strcmp(env, to_string(i)) != 0) continue;
+                while (!usable(i)) i = static_cast<isa>(static_cast<int>(i) - 1);
+                return i;
+            }
+            return detected_isa(); // unknown name: ignore
+        }
+
+        std::atomic<const detail::kernel_table*>& current() noexcept {
+            static std::atomic<const detail::kernel_table*> table{ compiled_table(initial_isa()) };
+            return table;
+        }
+
+        const detail::kernel_table& active() noexcept {
+            return *current().load(std::memory_order_acquire);
+        }
+
+    } // namespace
+
+    const char* to_string(isa i) noexcept {
+        switch (i) {
+        case isa::scalar: return "scalar";
+        case isa::sse2: return "sse2";
+        case isa::avx2: return "avx2";
+        case isa::avx512: return "avx512";
+        }
+        return "unknown";
+    }
+
+    isa detected_isa() noexcept {
+        static const isa best = detect();
+        return best;
+    }
+
+    isa active_isa() noexcept {
+        return active().which;
+    }
+
+    bool set_isa(isa i) noexcept {
+        if (!usable(i)) return false;
+        current().store(compiled_table(i), std::memory_order_release);
+        return true;
+    }
+
+    float dot(const float* x, const float* y, std::size_t n) noexcept { return active().f32.dot(x, y, n); }
+    double dot(const double* x, const double* y, std::size_t n) noexcept { return active().f64.dot(x, y, n); }
+
+    void axpy(float alpha, const float* x, float* y, std::size_t n) noexcept { active().f32.axpy(alpha, x, y, n); }
+    void axpy(double alpha, const double* x, double* y, std::size_t n) noexcept { active().f64.axpy(alpha, x, y, n); }
+
+    float sum(const float* x, std::size_t n) noexcept { return active().f32.sum(x, n); }
+    double sum(const double* x, std::size_t n) noexcept { return active().f64.sum(x, n); }
+
+    void sum_rows(const float* x, std::size_t rows, std::size_t n, float* out) noexcept {
+        active().f32.sum_rows(x, rows, n, out);
+    }
+    void sum_rows(const double* x, std::size_t rows, std::size_t n, double* out) noexcept {
+        active().f64.sum_rows(x, rows, n, out);
+    }
+
+    void gemm(const float* A, const float* B, float* C, std::size_t m, std::size_t k, std::size_t n) noexcept {
+        active().f32.gemm(A, B, C, m, k, n);
+    }
+    void gemm(const double* A, const double* B, double* C, std::size_t m, std::size_t k, std::size_t n) noexcept {
+        active().f64.gemm(A, B, C, m, k, n);
+    }
+
+    std::size_t solve_batched(float* A, float* b, std::size_t count, std::size_t n, float pivot_eps,
+        core::error_code* status) noexcept {
+        return active().f32.solve_batched(A, b, count, n, pivot_eps, status);
+    }
+    std::size_t solve_batched(double* A, double* b, std::size_t count, std::size_t n, double pivot_eps,
+        core::error_code* status) noexcept {
+        return active().f64.solve_batched(A, b, count, n, pivot_eps, status);
+    }
+
+} // namespace mathlib::kernels
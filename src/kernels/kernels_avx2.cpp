@@ -0,0 +1,4 @@
+// Kernels for isa::avx2, compiled with -mavx2 -mfma (MSVC: /arch:AVX2).
+#define MATHLIB_KERNEL_NS avx2
+#define MATHLIB_KERNEL_BYTES 32
+#include "kernels_impl.hpp"
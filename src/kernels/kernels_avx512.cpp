@@ -0,0 +1,4 @@
+// Kernels for isa::avx512, compiled with -mavx512f -mavx512vl -mavx512dq -mavx512bw (MSVC: /arch:AVX512).
+#define MATHLIB_KERNEL_NS avx512
+#define MATHLIB_KERNEL_BYTES 64
+#include "kernels_impl.hpp"
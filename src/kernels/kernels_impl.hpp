@@ -0,0 +1,356 @@
+// Kernel bodies, included once by each kernels_<isa>.cpp after defining
+//   MATHLIB_KERNEL_NS     namespace (and table) name: scalar, sse2, ...
+//   MATHLIB_KERNEL_BYTES  vector register width in bytes (0 for scalar)
+// Each of those files is compiled with its instruction set's flags, so the
+// loops below are auto-vectorized to that width.
+//
+// Everything stays inside the per-set namespace: no shared inline
+// functions and no std:: templates. Otherwise the linker could keep a copy
+// compiled for a wider set than the CPU has and call it from any path.
+#include <cstddef>
+
+#include "table.hpp"
+
+#if defined(_MSC_VER)
+#define MATHLIB_RESTRICT __restrict
+#else
+#define MATHLIB_RESTRICT __restrict__
+#endif
+
+namespace mathlib::kernels::detail::MATHLIB_KERNEL_NS {
+    namespace {
+
+        // elements per vector register
+        template <typename T>
+        constexpr std::size_t lanes = MATHLIB_KERNEL_BYTES >= sizeof(T) ? MATHLIB_KERNEL_BYTES / sizeof(T) : 1;
+
+        // independent partial sums for reductions: four registers' worth
+        // keeps enough adds in flight to cover the add/FMA latency
+        template <typename T>
+        constexpr std::size_t accumulators = 4 * lanes<T>;
+
+        template <typename T>
+        T absolute(T x) noexcept { return x < T{} ? -x : x; }
+
+        template <typename T>
+        T combine(T* acc) noexcept {
+            for (std::size_t w = accumulators<T> / 2; w > 0; w /= 2) {
+                for (std::size_t j = 0; j < w; ++j) acc[j] += acc[j + w];
+            }
+            return acc[0];
+        }
+
+        template <typename T>
+        T dot(const T* x, const T* y, std::size_t n) noexcept {
+            constexpr std::size_t L = accumulators<T>;
+            T acc[L] = {};
+            std::size_t i = 0;
+            for (; i + L <= n; i += L) {
+                for (std::size_t j = 0; j < L; ++j) acc[j] += x[i + j] * y[i + j];
+            }
+            for (std::size_t j = 0; i + j < n; ++j) acc[j] += x[i + j] * y[i + j];
+            return combine(acc);
+        }
+
+        template <typename T>
+        void axpy(T alpha, const T* MATHLIB_RESTRICT x, T* MATHLIB_RESTRICT y, std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+        template <typename T>
+        T sum(const T* x, std::size_t n) noexcept {
+            constexpr std::size_t L = accumulators<T>;
+            T acc[L] = {};
+            std::size_t i = 0;
+            for (; i + L <= n; i += L) {
+                for (std::size_t j = 0; j < L; ++j) acc[j] += x[i + j];
+            }
+            for (std::size_t j = 0; i + j < n; ++j) acc[j] += x[i + j];
+            return combine(acc);
+        }
+
+        template <typename T>
+        void sum_rows(const T* x, std::size_t rows, std::size_t n, T* out) noexcept {
+            for (std::size_t r = 0; r < rows; ++r) out[r] = sum(x + r * n, n);
+        }
+
+        // GEMM blocking: an MR x NR tile of C is held in registers while a
+        // panel of up to KC columns of A / rows of B streams through it.
+        constexpr std::size_t MR = 4;
+        constexpr std::size_t KC = 256;
+
+#if defined(__GNUC__) && MATHLIB_KERNEL_BYTES > 0
+        // GCC/Clang vector extensions for the register tile: left to the
+        // auto-vectorizer, the 2D accumulator array was spilled (and
+        // reloaded with store-forwarding stalls) for some tile shapes.
+        // vec_u is the unaligned, may_alias form for loads and stores.
+        template <typename T>
+        struct vec_types {
+            typedef T vec __attribute__((vector_size(MATHLIB_KERNEL_BYTES)));
+            typedef T vec_u __attribute__((vector_size(MATHLIB_KERNEL_BYTES), aligned(sizeof(T)), may_alias));
+        };
+
+        // vectors per tile row: 16 accumulators fit AVX-512's 32 registers,
+        // 8 fit the 16 of SSE2/AVX2
+        constexpr std::size_t tile_vectors = MATHLIB_KERNEL_BYTES >= 64 ? 4 : 2;
+        template <typename T>
+        constexpr std::size_t NR = tile_vectors * lanes<T>;
+
+        // C[0:MR, 0:NR] += A[0:MR, 0:kc] * B[0:kc, 0:NR]
+        template <typename T>
+        void tile(const T* A, std::size_t lda, const T* B, std::size_t ldb, T* C, std::size_t ldc,
+            std::size_t kc) noexcept {
+            using vec = typename vec_types<T>::vec;
+            using vec_u = typename vec_types<T>::vec_u;
+            constexpr std::size_t L = lanes<T>, V = tile_vectors;
+            vec acc[MR][V] = {};
+            for (std::size_t p = 0; p < kc; ++p) {
+                vec b[V];
+                for (std::size_t v = 0; v < V; ++v) b[v] = *reinterpret_cast<const vec_u*>(B + p * ldb + v * L);
+                for (std::size_t i = 0; i < MR; ++i) {
+                    const T a = A[i * lda + p];
+                    for (std::size_t v = 0; v < V; ++v) acc[i][v] += a * b[v];
+                }
+            }
+            for (std::size_t i = 0; i < MR; ++i) {
+                for (std::size_t v = 0; v < V; ++v) {
+                    vec_u* c = reinterpret_cast<vec_u*>(C + i * ldc + v * L);
+                    *c = *c + acc[i][v];
+                }
+            }
+        }
+#else
+        template <typename T>
+        constexpr std::size_t NR = 4;
+
+        template <typename T>
+        void tile(const T* A, std::size_t lda, const T* B, std::size_t ldb, T* C, std::size_t ldc,
+            std::size_t kc) noexcept {
+            T acc[MR][NR<T>] = {};
+            for (std::size_t p = 0; p < kc; ++p) {
+                const T* b = B + p * ldb;
+                for (std::size_t i = 0; i < MR; ++i) {
+                    const T a = A[i * lda + p];
+                    for (std::size_t j = 0; j < NR<T>; ++j) acc[i][j] += a * b[j];
+                }
+            }
+            for (std::size_t i = 0; i < MR; ++i) {
+                for (std::size_t j = 0; j < NR<T>; ++j) C[i * ldc + j] += acc[i][j];
+            }
+        }
+#endif
+
+        // ragged edges of C, same summation order as tile()
+        template <typename T>
+        void edge_tile(const T* A, std::size_t lda, const T* B, std::size_t ldb, T* C, std::size_t ldc,
+            std::size_t mr, std::size_t nr, std::size_t kc) noexcept {
+            for (std::size_t i = 0; i < mr; ++i) {
+                for (std::size_t j = 0; j < nr; ++j) {
+                    T s{};
+                    for (std::size_t p = 0; p < kc; ++p) s += A[i * lda + p] * B[p * ldb + j];
+                    C[i * ldc + j] += s;
+                }
+            }
+        }
+
+        template <typename T>
+        void gemm(const T* A, const T* B, T* C, std::size_t m, std::size_t k, std::size_t n) noexcept {
+            constexpr std::size_t N_R = NR<T>;
+            for (std::size_t i = 0; i < m * n; ++i) C[i] = T{};
+            for (std::size_t p0 = 0; p0 < k; p0 += KC) {
+                const std::size_t kc = k - p0 < KC ? k - p0 : KC;
+                for (std::size_t i0 = 0; i0 < m; i0 += MR) {
+                    const std::size_t mr = m - i0 < MR ? m - i0 : MR;
+                    for (std::size_t j0 = 0; j0 < n; j0 += N_R) {
+                        const std::size_t nr = n - j0 < N_R ? n - j0 : N_R;
+                        const T* a = A + i0 * k + p0;
+                        const T* b = B + p0 * n + j0;
+                        T* c = C + i0 * n + j0;
+                        if (mr == MR && nr == N_R) tile(a, k, b, n, c, n, kc);
+                        else edge_tile(a, k, b, n, c, n, mr, nr, kc);
+                    }
+                }
+            }
+        }
+
+        // One system in place; the solution replaces b. Same elimination
+        // and singularity test as linalg::detail::gauss_solve.
+        template <typename T>
+        core::error_code solve_one(T* A, T* b, std::size_t n, T pivot_eps) noexcept {
+            for (std::size_t k = 0; k < n; ++k) {
+                std::size_t pivot = k;
+                T max_abs = absolute(A[k * n + k]);
+                for (std::size_t i = k + 1; i < n; ++i) {
+                    const T v = absolute(A[i * n + k]);
+                    if (v > max_abs) {
+                        max_abs = v;
+                        pivot = i;
+                    }
+                }
+                if (max_abs <= pivot_eps) return core::error_code::singular_matrix;
+
+                if (pivot != k) {
+                    for (std::size_t j = k; j < n; ++j) {
+                        const T t = A[k * n + j];
+                        A[k * n + j] = A[pivot * n + j];
+                        A[pivot * n + j] = t;
+                    }
+                    const T t = b[k];
+                    b[k] = b[pivot];
+                    b[pivot] = t;
+                }
+
+                const T* MATHLIB_RESTRICT row_k = A + k * n;
+                for (std::size_t i = k + 1; i < n; ++i) {
+                    T* MATHLIB_RESTRICT row_i = A + i * n;
+                    const T factor = row_i[k] / row_k[k];
+                    row_i[k] = T{};
+                    for (std::size_t j = k + 1; j < n; ++j) row_i[j] -= factor * row_k[j];
+                    b[i] -= factor * b[k];
+                }
+            }
+
+            for (std::size_t ii = n; ii-- > 0;) {
+                const T d = A[ii * n + ii];
+                if (absolute(d) <= pivot_eps) return core::error_code::singular_matrix;
+                T s = b[ii];
+                for (std::size_t j = ii + 1; j < n; ++j) s -= A[ii * n + j] * b[j];
+                b[ii] = s / d;
+            }
+            return core::error_code::ok;
+        }
+
+        // Systems up to this size are solved lanes<T> at a time, interleaved
+        // (entry e of system g at a[e * G + g]), so each step of the
+        // elimination is one vector operation across the group. Per-system
+        // pivoting becomes a select. Larger systems are solved one by one,
+        // where the row updates are long enough to vectorize on their own.
+        constexpr std::size_t interleave_max_n = 8;
+
+        template <typename T, std::size_t G, std::size_t n>
+        void solve_group(T* A, T* b, T pivot_eps, core::error_code* codes) noexcept {
+            T a[n * n * G];
+            T r[n * G];
+            bool failed[G] = {};
+            for (std::size_t g = 0; g < G; ++g) {
+                for (std::size_t e = 0; e < n * n; ++e) a[e * G + g] = A[g * n * n + e];
+                for (std::size_t i = 0; i < n; ++i) r[i * G + g] = b[g * n + i];
+            }
+            auto at = [&](std::size_t i, std::size_t j) { return a + (i * n + j) * G; };
+
+            for (std::size_t k = 0; k < n; ++k) {
+                T best[G];
+                std::size_t pivot[G];
+                for (std::size_t g = 0; g < G; ++g) {
+                    best[g] = absolute(at(k, k)[g]);
+                    pivot[g] = k;
+                }
+                for (std::size_t i = k + 1; i < n; ++i) {
+                    for (std::size_t g = 0; g < G; ++g) {
+                        const T v = absolute(at(i, k)[g]);
+                        pivot[g] = v > best[g] ? i : pivot[g];
+                        best[g] = v > best[g] ? v : best[g];
+                    }
+                }
+                for (std::size_t g = 0; g < G; ++g) failed[g] = failed[g] || best[g] <= pivot_eps;
+
+                // row k <-> row pivot[g], per system; rows no system
+                // pivots to are skipped
+                for (std::size_t i = k + 1; i < n; ++i) {
+                    bool any = false;
+                    for (std::size_t g = 0; g < G; ++g) any = any || pivot[g] == i;
+                    if (!any) continue;
+                    for (std::size_t j = k; j < n; ++j) {
+                        T* rk = at(k, j);
+                        T* ri = at(i, j);
+                        for (std::size_t g = 0; g < G; ++g) {
+                            const T x = rk[g], y = ri[g];
+                            rk[g] = pivot[g] == i ? y : x;
+                            ri[g] = pivot[g] == i ? x : y;
+                        }
+                    }
+                    for (std::size_t g = 0; g < G; ++g) {
+                        const T x = r[k * G + g], y = r[i * G + g];
+                        r[k * G + g] = pivot[g] == i ? y : x;
+                        r[i * G + g] = pivot[g] == i ? x : y;
+                    }
+                }
+
+                // a failed system keeps going on a unit pivot; its result
+                // is discarded
+                T d[G];
+                for (std::size_t g = 0; g < G; ++g) d[g] = failed[g] ? T(1) : at(k, k)[g];
+                for (std::size_t i = k + 1; i < n; ++i) {
+                    T factor[G];
+                    for (std::size_t g = 0; g < G; ++g) factor[g] = at(i, k)[g] / d[g];
+                    for (std::size_t j = k + 1; j < n; ++j) {
+                        T* ri = at(i, j);
+                        const T* rk = at(k, j);
+                        for (std::size_t g = 0; g < G; ++g) ri[g] -= factor[g] * rk[g];
+                    }
+                    for (std::size_t g = 0; g < G; ++g) r[i * G + g] -= factor[g] * r[k * G + g];
+                }
+            }
+
+            for (std::size_t ii = n; ii-- > 0;) {
+                T s[G], d[G];
+                for (std::size_t g = 0; g < G; ++g) {
+                    failed[g] = failed[g] || absolute(at(ii, ii)[g]) <= pivot_eps;
+                    d[g] = failed[g] ? T(1) : at(ii, ii)[g];
+                    s[g] = r[ii * G + g];
+                }
+                for (std::size_t j = ii + 1; j < n; ++j) {
+                    for (std::size_t g = 0; g < G; ++g) s[g] -= at(ii, j)[g] * r[j * G + g];
+                }
+                for (std::size_t g = 0; g < G; ++g) r[ii * G + g] = s[g] / d[g];
+            }
+
+            for (std::size_t g = 0; g < G; ++g) {
+                codes[g] = failed[g] ? core::error_code::singular_matrix : core::error_code::ok;
+                if (failed[g]) continue;
+                for (std::size_t i = 0; i < n; ++i) b[g * n + i] = r[i * G + g];
+            }
+        }
+
+        template <typename T>
+        std::size_t solve_batched(T* A, T* b, std::size_t count, std::size_t n, T pivot_eps,
+            core::error_code* status) noexcept {
+            constexpr std::size_t G = lanes<T>;
+            std::size_t failed = 0;
+            std::size_t s = 0;
+            if (G > 1 && n <= interleave_max_n) {
+                // one instantiation per size, so the loops over n unroll
+                using group_fn = void (*)(T*, T*, T, core::error_code*) noexcept;
+                constexpr group_fn groups[] = { nullptr,
+                    &solve_group<T, G, 1>, &solve_group<T, G, 2>, &solve_group<T, G, 3>, &solve_group<T, G, 4>,
+                    &solve_group<T, G, 5>, &solve_group<T, G, 6>, &solve_group<T, G, 7>, &solve_group<T, G, 8> };
+                static_assert(sizeof(groups) / sizeof(groups[0]) == interleave_max_n + 1);
+                for (; n > 0 && s + G <= count; s += G) {
+                    core::error_code codes[G];
+                    groups[n](A + s * n * n, b + s * n, pivot_eps, codes);
+                    for (std::size_t g = 0; g < G; ++g) {
+                        if (status) status[s + g] = codes[g];
+                        if (codes[g] != core::error_code::ok) ++failed;
+                    }
+                }
+            }
+            for (; s < count; ++s) {
+                const core::error_code code = solve_one(A + s * n * n, b + s * n, n, pivot_eps);
+                if (status) status[s] = code;
+                if (code != core::error_code::ok) ++failed;
+            }
+            return failed;
+        }
+
+        template <typename T>
+        constexpr typed_table<T> make_table() {
+            return { &dot<T>, &axpy<T>, &sum<T>, &sum_rows<T>, &gemm<T>, &solve_batched<T> };
+        }
+
+    } // namespace
+
+    const kernel_table table = { isa::MATHLIB_KERNEL_NS, make_table<float>(), make_table<double>() };
+
+} // namespace mathlib::kernels::detail::MATHLIB_KERNEL_NS
+
+#undef MATHLIB_RESTRICT
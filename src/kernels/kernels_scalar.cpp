@@ -0,0 +1,4 @@
+// Kernels for isa::scalar, compiled with auto-vectorization disabled: the reference path.
+#define MATHLIB_KERNEL_NS scalar
+#define MATHLIB_KERNEL_BYTES 0
+#include "kernels_impl.hpp"
@@ -0,0 +1,4 @@
+// Kernels for isa::sse2, x86-64 baseline (SSE2), no extra flags.
+#define MATHLIB_KERNEL_NS sse2
+#define MATHLIB_KERNEL_BYTES 16
+#include "kernels_impl.hpp"
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/kernels/kernels.hpp"
+
+// Internal: the function table each kernels_<isa>.cpp exports.
+namespace mathlib::kernels::detail {
+
+    template <typename T>
+    struct typed_table {
+        T (*dot)(const T*, const T*, std::size_t) noexcept;
+        void (*axpy)(T, const T*, T*, std::size_t) noexcept;
+        T (*sum)(const T*, std::size_t) noexcept;
+        void (*sum_rows)(const T*, std::size_t, std::size_t, T*) noexcept;
+        void (*gemm)(const T*, const T*, T*, std::size_t, std::size_t, std::size_t) noexcept;
+        std::size_t (*solve_batched)(T*, T*, std::size_t, std::size_t, T, core::error_code*) noexcept;
+    };
+
+    struct kernel_table {
+        isa which;
+        typed_table<float> f32;
+        typed_table<double> f64;
+    };
+
+    // Defined only for the sets CMake compiled (see MATHLIB_KERNELS_X86).
+    namespace scalar { extern const kernel_table table; }
+    namespace sse2 { extern const kernel_table table; }
+    namespace avx2 { extern const kernel_table table; }
+    namespace avx512 { extern const kernel_table table; }
+
+} // namespace mathlib::kernels::detail
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+
+#include "mathlib/core/almost_equal.hpp"
+#include "mathlib/core/cmath.hpp"
+#include "mathlib/core/constants.hpp"
+#include "mathlib/core/table.hpp"
+#include "mathlib/calculus/diff.hpp"
+#include "mathlib/calculus/integrate.hpp"
+#include "mathlib/calculus/integrate_vec.hpp"
+#include "mathlib/calculus/root.hpp"
+#include "mathlib/linalg/solve.hpp"
+
+namespace cmath = mathlib::core::cmath;
+using mathlib::core::almost_equal;
+
+namespace {
+
+    constexpr double pi = mathlib::core::pi_v<double>;
+
+    constexpr double bell(double t) { return cmath::exp(-t * t / 2); }
+
+    // integral of the standard normal density over [0, x], baked at compile time
+    constexpr auto normal_area = mathlib::core::constexpr_table<65>([](double x) {
+        return mathlib::calculus::integrate_gauss_kronrod(bell, 0.0, x, 4).value / cmath::sqrt(2 * pi);
+        }, 0.0, 4.0);
+
+} // namespace
+
+// math helpers
+static_assert(cmath::abs(-2.5) == 2.5);
+static_assert(almost_equal(cmath::sqrt(2.0), 1.4142135623730951, 3e-16, 0.0));
+static_assert(almost_equal(cmath::sqrt(1e-300), 1e-150, 3e-16, 0.0));
+static_assert(cmath::sqrt(0.0) == 0.0 && cmath::sqrt(16.0) == 4.0);
+static_assert(almost_equal(cmath::exp(1.0), mathlib::core::e_v<double>, 4e-16, 0.0));
+static_assert(almost_equal(cmath::exp(-700.0) * cmath::exp(700.0), 1.0, 1e-13, 0.0));
+static_assert(almost_equal(cmath::sin(pi / 6), 0.5, 1e-15, 1e-15));
+static_assert(almost_equal(cmath::cos(100.0), 0.86231887228768389, 1e-13, 0.0));
+
+// calculus
+static_assert(almost_equal(mathlib::calculus::derivative_central([](double x) { return x * x * x; }, 2.0, 1e-4),
+    12.0, 1e-7, 0.0));
+static_assert(almost_equal(mathlib::calculus::integrate_simpson([](double x) { return x * x; }, 0.0, 3.0, 10),
+    9.0, 1e-14, 0.0));
+static_assert(almost_equal(mathlib::calculus::integrate_adaptive_simpson(bell, -8.0, 8.0, 1e-12),
+    cmath::sqrt(2 * pi), 1e-11, 0.0));
+static_assert(almost_equal(mathlib::calculus::root_bisection([](double x) { return x * x - 2.0; }, 0.0, 2.0),
+    1.4142135623730951, 1e-12, 0.0));
+static_assert(almost_equal(mathlib::calculus::root_newton([](double x) { return cmath::cos(x) - x; }, 1.0),
+    0.73908513321516064, 1e-12, 0.0));
+static_assert(mathlib::calculus::integrate_gauss_kronrod(bell, 0.0, 1.0).error < 1e-14);
+
+// linear algebra
+static_assert([] {
+    mathlib::linalg::Matrix<3, 3, double> A{ 4, -2, 1, -2, 4, -2, 1, -2, 4 };
+    mathlib::linalg::Vector<3, double> x{ 1, 2, 3 };
+    const auto y = mathlib::linalg::solve(A, mathlib::linalg::mul(A, x));
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (!almost_equal(y[i], x[i], 1e-14, 1e-14)) return false;
+    }
+    return true;
+    }());
+
+TEST(Constexpr, HelpersMatchCmathAtRuntime) {
+    for (double x : { -3.0, -0.5, 0.0, 0.25, 1.0, 7.5, 40.0 }) {
+        EXPECT_EQ(cmath::exp(x), std::exp(x));
+        EXPECT_EQ(cmath::sin(x), std::sin(x));
+        EXPECT_EQ(cmath::cos(x), std::cos(x));
+        EXPECT_EQ(cmath::sqrt(std::abs(x)), std::sqrt(std::abs(x)));
+    }
+}
+
+TEST(Constexpr, GaussKronrodExactForPolynomials) {
+    // K15 integrates polynomials up to degree 22 exactly, G7 up to 13
+    auto p = [](double x) { return std::pow(x, 12) - 3.0 * std::pow(x, 5) + 1.0; };
+    const auto r = mathlib::calculus::gauss_kronrod15(p, -1.0, 2.0);
+    const double exact = (std::pow(2.0, 13) + 1.0) / 13.0 - 0.5 * (std::pow(2.0, 6) - 1.0) + 3.0;
+    EXPECT_NEAR(r.value, exact, 1e-12 * exact);
+    EXPECT_LT(r.error, 1e-10);
+
+    // a kink is not polynomial: the estimate must cover the real error
+    auto kink = [](double x) { return std::abs(x - 0.3); };
+    const auto k = mathlib::calculus::gauss_kronrod15(kink, 0.0, 1.0);
+    EXPECT_LE(std::abs(k.value - (0.045 + 0.245)), k.error);
+
+    const auto c = mathlib::calculus::integrate_gauss_kronrod([](double x) { return std::sin(x); }, 0.0, pi, 8);
+    EXPECT_NEAR(c.value, 2.0, 1e-14);
+}
+
+TEST(Constexpr, TableMatchesRuntimeIntegral) {
+    static_assert(normal_area[0] == 0.0);
+    EXPECT_NEAR(normal_area[16], 0.5 * std::erf(1.0 / std::sqrt(2.0)), 1e-15);
+    EXPECT_NEAR(normal_area.back(), 0.5 * std::erf(4.0 / std::sqrt(2.0)), 1e-15);
+
+    // lookup between knots
+    const double x = 1.96;
+    const double approx = mathlib::core::interpolate(normal_area, 0.0, 4.0, x);
+    EXPECT_NEAR(approx, 0.5 * std::erf(x / std::sqrt(2.0)), 1e-3);
+    EXPECT_EQ(mathlib::core::interpolate(normal_area, 0.0, 4.0, -1.0), normal_area.front());
+    EXPECT_EQ(mathlib::core::interpolate(normal_area, 0.0, 4.0, 9.0), normal_area.back());
+}
+
+TEST(Constexpr, RuntimeCallsUnchanged) {
+    // the same functions still work (and throw) at run time
+    EXPECT_THROW(mathlib::calculus::derivative_central([](double x) { return x; }, 1.0, 0.0),
+        mathlib::core::domain_error);
+    mathlib::linalg::Matrix<2, 2, double> S{ 1, 2, 2, 4 };
+    EXPECT_THROW(mathlib::linalg::solve(S, mathlib::linalg::Vector<2, double>{ 1, 1 }), mathlib::core::domain_error);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include "mathlib/ode/ensemble.hpp"
+#include "mathlib/ode/solvers.hpp"
+#include "mathlib/core/executor.hpp"
+
+namespace {
+
+    using V2 = mathlib::linalg::Vector<2, double>;
+    constexpr std::size_t W = 4;
+    using B = mathlib::ode::Batch<2, double, W>;
+    using L = mathlib::ode::Lanes<double, W>;
+
+    // Oscillators with member-dependent frequency omega_m = 1 + m / 10
+    struct Oscillators {
+        B operator()(const L&, const B& y, std::size_t first) const {
+            B d;
+            for (std::size_t l = 0; l < W; ++l) {
+                const double w = 1.0 + static_cast<double>(first + l) / 10.0;
+                d[0][l] = y[1][l];
+                d[1][l] = -w * w * y[0][l];
+            }
+            return d;
+        }
+    };
+
+    // Per-member frequencies looked up in a table sized exactly to the
+    // ensemble; at() throws on a padded lane's index
+    struct TabulatedOscillators {
+        const std::vector<double>* omega;
+        B operator()(const L&, const B& y, std::size_t first, std::size_t active) const {
+            B d{};
+            for (std::size_t l = 0; l < active; ++l) {
+                const double w = omega->at(first + l);
+                d[0][l] = y[1][l];
+                d[1][l] = -w * w * y[0][l];
+            }
+            return d;
+        }
+    };
+
+    std::vector<V2> initial_states(std::size_t n) {
+        std::vector<V2> y0s;
+        for (std::size_t m = 0; m < n; ++m) y0s.push_back(V2{ 1.0 + 0.1 * static_cast<double>(m), 0.0 });
+        return y0s;
+    }
+
+} // namespace
+
+TEST(Ensemble, Rk4MatchesAnalyticPerMember) {
+    const auto y0s = initial_states(11); // not a multiple of W: last batch is padded
+    mathlib::ode::EnsembleStats st;
+    const auto ys = mathlib::ode::solve_ensemble_rk4<W>(Oscillators{}, 0.0, y0s, 2.0, 1e-3,
+        mathlib::core::inline_executor{}, nullptr, &st);
+
+    ASSERT_EQ(ys.size(), 11u);
+    EXPECT_EQ(st.batches, 3u);
+    for (std::size_t m = 0; m < ys.size(); ++m) {
+        const double w = 1.0 + static_cast<double>(m) / 10.0;
+        EXPECT_NEAR(ys[m][0], y0s[m][0] * std::cos(w * 2.0), 1e-10);
+        EXPECT_NEAR(ys[m][1], -y0s[m][0] * w * std::sin(w * 2.0), 1e-10);
+    }
+}
+
+TEST(Ensemble, Rk45LanesMatchScalarStepper) {
+    const auto y0s = initial_states(9);
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-8;
+    opt.atol = 1e-10;
+
+    mathlib::ode::EnsembleStats st;
+    const auto ys = mathlib::ode::solve_ensemble_rk45<W>(Oscillators{}, 0.0, y0s, 5.0, opt,
+        mathlib::core::inline_executor{}, nullptr, &st);
+
+    std::size_t accepted = 0;
+    for (std::size_t m = 0; m < y0s.size(); ++m) {
+        const double w = 1.0 + static_cast<double>(m) / 10.0;
+        auto f = [w](double, const V2& y) { return V2{ y[1], -w * w * y[0] }; };
+        mathlib::ode::Rk45Stats s;
+        const auto [t, y] = mathlib::ode::solve_rk45(f, 0.0, y0s[m], 5.0, opt,
+            [](double, const V2&) {}, &s);
+        EXPECT_DOUBLE_EQ(t, 5.0);
+        // same controller per lane; only rounding in the stage sums differs
+        EXPECT_NEAR(ys[m][0], y[0], 1e-9);
+        EXPECT_NEAR(ys[m][1], y[1], 1e-9);
+        EXPECT_NEAR(ys[m][0], y0s[m][0] * std::cos(w * 5.0), 1e-6);
+        accepted += s.accepted;
+    }
+    EXPECT_NEAR(static_cast<double>(st.accepted), static_cast<double>(accepted), 0.02 * accepted);
+}
+
+TEST(Ensemble, ActiveLaneCountGuardsPerMemberData) {
+    const std::size_t members = 11; // 11 % W != 0: last batch has 3 of 4 lanes
+    const auto y0s = initial_states(members);
+    std::vector<double> omega(members);
+    for (std::size_t m = 0; m < members; ++m) omega[m] = 1.0 + static_cast<double>(m) / 10.0;
+    const TabulatedOscillators f{ &omega };
+
+    const auto fixed = mathlib::ode::solve_ensemble_rk4<W>(f, 0.0, y0s, 2.0, 1e-3,
+        mathlib::core::inline_executor{}, nullptr);
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-10;
+    opt.atol = 1e-12;
+    const auto adaptive = mathlib::ode::solve_ensemble_rk45<W>(f, 0.0, y0s, 2.0, opt,
+        mathlib::core::inline_executor{}, nullptr);
+
+    for (std::size_t m = 0; m < members; ++m) {
+        EXPECT_NEAR(fixed[m][0], y0s[m][0] * std::cos(omega[m] * 2.0), 1e-10);
+        EXPECT_NEAR(adaptive[m][0], y0s[m][0] * std::cos(omega[m] * 2.0), 1e-8);
+    }
+}
+
+TEST(Ensemble, ThreadPoolMatchesSerialAndStreamsEveryMember) {
+    const auto y0s = initial_states(37);
+    const mathlib::ode::Rk45Options<double> opt;
+
+    const auto serial = mathlib::ode::solve_ensemble_rk45<W>(Oscillators{}, 0.0, y0s, 3.0, opt,
+        mathlib::core::inline_executor{}, nullptr);
+
+    std::mutex mu;
+    std::vector<double> last_t(y0s.size(), -1.0);
+    std::vector<std::size_t> calls(y0s.size(), 0);
+    auto sink = [&](std::size_t m, double t, const V2&) {
+        std::lock_guard<std::mutex> lock(mu);
+        EXPECT_GT(t, last_t[m]); // ordered per member
+        last_t[m] = t;
+        ++calls[m];
+    };
+
+    mathlib::core::thread_pool pool(4);
+    const auto parallel = mathlib::ode::solve_ensemble_rk45<W>(Oscillators{}, 0.0, y0s, 3.0, opt, pool, sink);
+
+    for (std::size_t m = 0; m < y0s.size(); ++m) {
+        EXPECT_EQ(parallel[m][0], serial[m][0]);
+        EXPECT_EQ(parallel[m][1], serial[m][1]);
+        EXPECT_DOUBLE_EQ(last_t[m], 3.0);
+        EXPECT_GE(calls[m], 2u);
+    }
+}
+
+TEST(Ensemble, DefaultLanesConvenienceOverload) {
+    auto f = [](const auto&, const auto& y) {
+        auto d = y;
+        for (std::size_t l = 0; l < d[0].size(); ++l) d[0][l] = -y[0][l];
+        return d;
+    };
+    std::vector<mathlib::linalg::Vector<1, double>> y0s(20, mathlib::linalg::Vector<1, double>{ 1.0 });
+    const auto ys = mathlib::ode::solve_ensemble_rk45(f, 0.0, y0s, 1.0);
+    for (const auto& y : ys) EXPECT_NEAR(y[0], std::exp(-1.0), 1e-6);
+}
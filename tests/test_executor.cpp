@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "mathlib/core/executor.hpp"
+#include "mathlib/calculus/grad.hpp"
+#include "mathlib/calculus/integrate.hpp"
+#include "mathlib/calculus/integrate_vec.hpp"
+#include "mathlib/core/constants.hpp"
+
+TEST(Executor, ThreadPoolRunsEveryIndexOnce) {
+    mathlib::core::thread_pool pool(3);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.bulk(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+    for (auto& h : hits) EXPECT_EQ(h.load(), 1);
+}
+
+TEST(Executor, NestedBulkAndExceptions) {
+    mathlib::core::thread_pool pool(2);
+    std::atomic<int> total{ 0 };
+    pool.bulk(8, [&](std::size_t) {
+        pool.bulk(8, [&](std::size_t) { total.fetch_add(1); });
+        });
+    EXPECT_EQ(total.load(), 64);
+
+    EXPECT_THROW(pool.bulk(16, [](std::size_t i) {
+        if (i == 5) throw mathlib::core::domain_error("boom");
+        }), mathlib::core::domain_error);
+}
+
+TEST(Executor, SimpsonBitReproducible) {
+    const double pi = mathlib::core::pi_v<double>;
+    auto f = [](double x) { return std::sin(x) * std::exp(-0.1 * x); };
+
+    mathlib::core::thread_pool pool2(2), pool5(5);
+    const std::size_t n = 200000;
+    double serial = mathlib::calculus::integrate_simpson(mathlib::core::inline_executor{}, f, 0.0, pi, n);
+    double p2 = mathlib::calculus::integrate_simpson(pool2, f, 0.0, pi, n);
+    double p5 = mathlib::calculus::integrate_simpson(pool5, f, 0.0, pi, n);
+
+    EXPECT_EQ(serial, p2);
+    EXPECT_EQ(serial, p5);
+    EXPECT_NEAR(serial, mathlib::calculus::integrate_simpson(f, 0.0, pi, n), 1e-12);
+}
+
+TEST(Executor, AdaptiveSimpsonMatchesSerialExactly) {
+    auto f = [](double x) { return 1.0 / (1e-3 + x * x); };
+    mathlib::core::thread_pool pool(4);
+
+    double serial = mathlib::calculus::integrate_adaptive_simpson(f, -1.0, 1.0, 1e-10);
+    double par = mathlib::calculus::integrate_adaptive_simpson(pool, f, -1.0, 1.0, 1e-10);
+    EXPECT_EQ(serial, par);
+
+    using mathlib::linalg::Vector;
+    auto fv = [](double x) { return Vector<2, double>{ std::cos(x), 1.0 / (1e-2 + x * x) }; };
+    auto vs = mathlib::calculus::integrate_adaptive_simpson_vec<decltype(fv), 2, double>(fv, -1.0, 1.0, 1e-10);
+    auto vp = mathlib::calculus::integrate_adaptive_simpson_vec<mathlib::core::thread_pool&, decltype(fv), 2, double>(
+        pool, fv, -1.0, 1.0, 1e-10);
+    EXPECT_EQ(vs[0], vp[0]);
+    EXPECT_EQ(vs[1], vp[1]);
+}
+
+TEST(Executor, ParallelGradient) {
+    using mathlib::linalg::Vector;
+    auto f = [](const Vector<4, double>& v) {
+        return v[0] * v[0] + 2.0 * v[1] * v[1] + 3.0 * v[2] * v[2] + 4.0 * v[3] * v[3];
+        };
+    mathlib::core::thread_pool pool(3);
+    Vector<4, double> x{ 1.0, 1.0, 1.0, 1.0 };
+    auto gs = mathlib::calculus::gradient(f, x);
+    auto gp = mathlib::calculus::gradient(pool, f, x);
+    for (std::size_t i = 0; i < 4; ++i) EXPECT_EQ(gs[i], gp[i]);
+}
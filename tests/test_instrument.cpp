@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mathlib/core/instrument.hpp"
+#include "mathlib/calculus/diff.hpp"
+#include "mathlib/calculus/integrate.hpp"
+#include "mathlib/calculus/root.hpp"
+#include "mathlib/linalg/lu.hpp"
+#include "mathlib/linalg/solve.hpp"
+#include "mathlib/ode/solvers.hpp"
+
+static_assert(std::is_empty_v<mathlib::core::null_stats>);
+static_assert(mathlib::core::stats_policy<mathlib::core::null_stats>);
+static_assert(mathlib::core::stats_policy<mathlib::core::basic_stats>);
+
+TEST(Instrument, RootFindersReportConvergence) {
+    int calls = 0;
+    auto f = [&calls](double x) { ++calls; return x * x - 2.0; };
+
+    mathlib::core::basic_stats st;
+    const double r = mathlib::calculus::root_newton(f, 1.0, 1e-12, 50, 1e-6, st);
+    EXPECT_NEAR(r, std::sqrt(2.0), 1e-10);
+    EXPECT_TRUE(st.converged);
+    EXPECT_EQ(st.evals, static_cast<std::size_t>(calls));
+    EXPECT_GT(st.iterations, 0u);
+    EXPECT_GE(st.wall_seconds, 0.0);
+
+    st.reset();
+    mathlib::calculus::root_newton(f, 100.0, 1e-12, 3, 1e-6, st);
+    EXPECT_FALSE(st.converged);
+    EXPECT_EQ(st.iterations, 3u);
+
+    st.reset();
+    mathlib::calculus::root_bisection(f, 0.0, 2.0, 1e-12, 5, st);
+    EXPECT_FALSE(st.converged);
+    EXPECT_NEAR(st.error_estimate, 2.0 / 64, 1e-15);
+}
+
+TEST(Instrument, TraceHookStreamsIterations) {
+    std::vector<mathlib::core::trace_event> events;
+    mathlib::core::trace_stats st([&events](const mathlib::core::trace_event& e) { events.push_back(e); });
+
+    mathlib::calculus::root_bisection([](double x) { return x - 0.3; }, 0.0, 1.0, 1e-9, 200, st);
+    ASSERT_EQ(events.size(), st.iterations);
+    EXPECT_EQ(std::string(events.front().source), "root_bisection");
+    EXPECT_LT(events.back().error, events.front().error);
+}
+
+TEST(Instrument, AdaptiveSimpsonDepthAndErrors) {
+    int calls = 0;
+    auto f = [&calls](double x) { ++calls; return std::sqrt(x); };
+
+    mathlib::core::basic_stats st;
+    const double v = mathlib::calculus::integrate_adaptive_simpson(f, 0.0, 1.0, 1e-10, 50, st);
+    EXPECT_NEAR(v, 2.0 / 3.0, 1e-9);
+    EXPECT_EQ(st.evals, static_cast<std::size_t>(calls));
+    EXPECT_TRUE(st.converged);
+    EXPECT_GT(st.max_depth, 10u);
+    EXPECT_GT(st.accepted, 1u);
+    EXPECT_GT(st.error_estimate, 0.0);
+
+    st.reset();
+    mathlib::calculus::integrate_adaptive_simpson(f, 0.0, 1.0, 1e-14, 4, st);
+    EXPECT_FALSE(st.converged); // depth limit hit near the sqrt singularity
+    EXPECT_GT(st.rejected, 0u);
+    EXPECT_EQ(st.max_depth, 4u);
+
+    st.reset();
+    mathlib::calculus::integrate_simpson(f, 0.0, 1.0, 100, st);
+    EXPECT_EQ(st.evals, 101u);
+
+    st.reset();
+    mathlib::calculus::derivative_central(f, 1.0, 1e-6, st);
+    EXPECT_EQ(st.evals, 2u);
+}
+
+TEST(Instrument, Rk45StatsMatchStepper) {
+    using V2 = mathlib::linalg::Vector<2, double>;
+    auto f = [](double, const V2& y) { return V2{ y[1], (1 - y[0] * y[0]) * y[1] - y[0] }; };
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-8;
+
+    std::size_t steps = 0;
+    mathlib::core::trace_stats st([&steps](const mathlib::core::trace_event&) { ++steps; });
+    mathlib::ode::solve_rk45(f, 0.0, V2{ 2.0, 0.0 }, 20.0, opt, [](double, const V2&) {}, st);
+
+    mathlib::ode::Rk45Stats ref;
+    mathlib::ode::solve_rk45(f, 0.0, V2{ 2.0, 0.0 }, 20.0, opt, [](double, const V2&) {}, &ref);
+    EXPECT_EQ(st.accepted, ref.accepted);
+    EXPECT_EQ(st.rejected, ref.rejected);
+    EXPECT_EQ(st.evals, ref.f_evals);
+    EXPECT_EQ(steps, ref.accepted);
+    EXPECT_TRUE(st.converged);
+    EXPECT_LE(st.error_estimate, 1.0);
+
+    mathlib::core::basic_stats rk4;
+    mathlib::ode::solve_rk4(f, 0.0, V2{ 2.0, 0.0 }, 1.0, 0.125, [](double, const V2&) {}, rk4);
+    EXPECT_EQ(rk4.accepted, 8u);
+    EXPECT_EQ(rk4.evals, 32u);
+}
+
+TEST(Instrument, PivotGrowth) {
+    // Wilkinson's matrix: partial pivoting grows entries by 2^(N-1)
+    constexpr std::size_t N = 8;
+    mathlib::linalg::Matrix<N, N, double> A;
+    mathlib::linalg::Vector<N, double> b;
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) A(i, j) = (i == j || j == N - 1) ? 1.0 : (i > j ? -1.0 : 0.0);
+        b[i] = 1.0;
+    }
+
+    mathlib::core::basic_stats st;
+    mathlib::linalg::solve(A, b, 1e-12, st);
+    EXPECT_DOUBLE_EQ(st.pivot_growth, 128.0);
+    EXPECT_EQ(st.iterations, N);
+
+    mathlib::core::basic_stats lu;
+    mathlib::linalg::lu_factor(A, 1e-12, lu);
+    EXPECT_DOUBLE_EQ(lu.pivot_growth, 128.0);
+
+    mathlib::core::basic_stats id;
+    mathlib::linalg::solve(mathlib::linalg::Matrix<3, 3, double>::identity(), mathlib::linalg::Vector<3, double>{ 1, 2, 3 }, 1e-12, id);
+    EXPECT_DOUBLE_EQ(id.pivot_growth, 1.0);
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "mathlib/kernels/kernels.hpp"
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/solve.hpp"
+
+namespace kernels = mathlib::kernels;
+using kernels::isa;
+
+namespace {
+
+    constexpr isa all_isas[] = { isa::scalar, isa::sse2, isa::avx2, isa::avx512 };
+
+    std::vector<double> values(std::size_t n, unsigned seed) {
+        std::vector<double> v(n);
+        unsigned s = seed;
+        for (auto& x : v) {
+            s = s * 1664525u + 1013904223u;
+            x = static_cast<double>(s >> 8) / static_cast<double>(1u << 24) - 0.5;
+        }
+        return v;
+    }
+
+    template <typename T>
+    std::vector<T> as(const std::vector<double>& v) {
+        return std::vector<T>(v.begin(), v.end());
+    }
+
+    // runs f once on every path this machine supports, then restores the
+    // active one
+    template <typename F>
+    void on_every_path(F f) {
+        const isa before = kernels::active_isa();
+        for (isa i : all_isas) {
+            if (!kernels::set_isa(i)) continue;
+            SCOPED_TRACE(kernels::to_string(i));
+            ASSERT_EQ(kernels::active_isa(), i);
+            f(i);
+        }
+        kernels::set_isa(before);
+    }
+
+} // namespace
+
+// Must stay first: under ctest's kernels_isa_* runs MATHLIB_ISA is set and
+// nothing has called set_isa yet.
+TEST(Kernels, EnvironmentSelectsPath) {
+    const char* env = std::getenv("MATHLIB_ISA");
+    if (env == nullptr) {
+        EXPECT_EQ(kernels::active_isa(), kernels::detected_isa());
+        return;
+    }
+    for (isa i : all_isas) {
+        if (std::strcmp(env, kernels::to_string(i)) != 0) continue;
+        // a request above what the CPU supports is lowered
+        EXPECT_LE(kernels::active_isa(), i);
+        if (i <= kernels::detected_isa()) {
+            EXPECT_EQ(kernels::active_isa(), i);
+        }
+        return;
+    }
+    ADD_FAILURE() << "unknown MATHLIB_ISA=" << env;
+}
+
+TEST(Kernels, DetectionAndSelection) {
+    EXPECT_TRUE(kernels::set_isa(isa::scalar));
+    EXPECT_EQ(kernels::active_isa(), isa::scalar);
+    EXPECT_TRUE(kernels::set_isa(kernels::detected_isa()));
+    if (kernels::detected_isa() != isa::avx512) {
+        const isa above = static_cast<isa>(static_cast<int>(kernels::detected_isa()) + 1);
+        EXPECT_FALSE(kernels::set_isa(above));
+        EXPECT_EQ(kernels::active_isa(), kernels::detected_isa());
+    }
+    EXPECT_STREQ(kernels::to_string(isa::avx2), "avx2");
+}
+
+TEST(Kernels, ReductionsMatchScalar) {
+    for (std::size_t n : { 0u, 1u, 7u, 33u, 1000u, 4099u }) {
+        const auto x = values(n, 1), y = values(n, 2);
+        double ref_dot = 0, ref_sum = 0, mag = 1e-300;
+        for (std::size_t i = 0; i < n; ++i) {
+            ref_dot += x[i] * y[i];
+            ref_sum += x[i];
+            mag += std::abs(x[i] * y[i]) + std::abs(x[i]);
+        }
+        const auto xf = as<float>(x), yf = as<float>(y);
+
+        on_every_path([&](isa) {
+            EXPECT_NEAR(kernels::dot(x.data(), y.data(), n), ref_dot, 1e-14 * mag) << n;
+            EXPECT_NEAR(kernels::sum(x.data(), n), ref_sum, 1e-14 * mag) << n;
+            EXPECT_NEAR(kernels::dot(xf.data(), yf.data(), n), ref_dot, 1e-5 * mag) << n;
+            EXPECT_NEAR(kernels::sum(xf.data(), n), ref_sum, 1e-5 * mag) << n;
+
+            auto z = y;
+            kernels::axpy(0.5, x.data(), z.data(), n);
+            for (std::size_t i = 0; i < n; ++i) ASSERT_NEAR(z[i], y[i] + 0.5 * x[i], 1e-16) << i;
+            });
+    }
+
+    // a batch of rows, e.g. function values on a grid
+    const std::size_t rows = 5, cols = 37;
+    const auto x = values(rows * cols, 3);
+    on_every_path([&](isa) {
+        std::vector<double> out(rows);
+        kernels::sum_rows(x.data(), rows, cols, out.data());
+        for (std::size_t r = 0; r < rows; ++r) {
+            double ref = 0;
+            for (std::size_t j = 0; j < cols; ++j) ref += x[r * cols + j];
+            EXPECT_NEAR(out[r], ref, 1e-14) << r;
+        }
+        });
+}
+
+TEST(Kernels, GemmMatchesMatrixProduct) {
+    // a fixed size against operator*, then ragged sizes (edge tiles, and
+    // k > 256 for more than one panel) against a plain loop
+    constexpr std::size_t N = 48;
+    mathlib::linalg::Matrix<N, N, double> A, B;
+    const auto a = values(N * N, 4), b = values(N * N, 5);
+    for (std::size_t i = 0; i < N * N; ++i) {
+        A.a[i] = a[i];
+        B.a[i] = b[i];
+    }
+    const auto ref = A * B;
+
+    on_every_path([&](isa) {
+        mathlib::linalg::Matrix<N, N, double> C;
+        kernels::gemm(A.a.data(), B.a.data(), C.a.data(), N, N, N);
+        for (std::size_t i = 0; i < N * N; ++i) ASSERT_NEAR(C.a[i], ref.a[i], 1e-13) << i;
+
+        for (auto [m, k, n] : { std::array<std::size_t, 3>{ 5, 7, 13 }, { 1, 300, 3 }, { 9, 513, 19 } }) {
+            const auto x = as<float>(values(m * k, 6)), y = as<float>(values(k * n, 7));
+            std::vector<float> z(m * n);
+            kernels::gemm(x.data(), y.data(), z.data(), m, k, n);
+            for (std::size_t i = 0; i < m; ++i) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    double s = 0;
+                    for (std::size_t p = 0; p < k; ++p) s += static_cast<double>(x[i * k + p]) * y[p * n + j];
+                    ASSERT_NEAR(z[i * n + j], s, 1e-5 * static_cast<double>(k)) << m << "x" << k << "x" << n;
+                }
+            }
+        }
+        });
+}
+
+TEST(Kernels, SolveBatchedMatchesSolve) {
+    constexpr std::size_t N = 4, count = 50;
+    std::vector<double> A = values(count * N * N, 8), b = values(count * N, 9);
+    for (std::size_t s = 0; s < count; ++s) {
+        for (std::size_t i = 0; i < N; ++i) A[s * N * N + i * N + i] += 2.0;
+    }
+    // one singular system in the middle
+    for (std::size_t j = 0; j < N; ++j) A[7 * N * N + 3 * N + j] = A[7 * N * N + j];
+
+    on_every_path([&](isa) {
+        auto M = A, x = b;
+        std::vector<mathlib::core::error_code> status(count);
+        EXPECT_EQ(kernels::solve_batched(M.data(), x.data(), count, N, 1e-12, status.data()), 1u);
+
+        for (std::size_t s = 0; s < count; ++s) {
+            if (s == 7) {
+                EXPECT_EQ(status[s], mathlib::core::error_code::singular_matrix);
+                continue;
+            }
+            EXPECT_EQ(status[s], mathlib::core::error_code::ok) << s;
+            mathlib::linalg::Matrix<N, N, double> As;
+            mathlib::linalg::Vector<N, double> bs;
+            for (std::size_t i = 0; i < N * N; ++i) As.a[i] = A[s * N * N + i];
+            for (std::size_t i = 0; i < N; ++i) bs[i] = b[s * N + i];
+            const auto ref = mathlib::linalg::solve(As, bs);
+            for (std::size_t i = 0; i < N; ++i) EXPECT_NEAR(x[s * N + i], ref[i], 1e-12) << s;
+        }
+
+        auto Mf = as<float>(A), xf = as<float>(b);
+        EXPECT_EQ(kernels::solve_batched(Mf.data(), xf.data(), count, N), 1u);
+        });
+}
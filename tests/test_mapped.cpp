@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mathlib/linalg/mapped.hpp"
+#include "mathlib/linalg/solve.hpp"
+
+namespace {
+
+    using M3 = mathlib::linalg::Matrix<3, 3, double>;
+    using V3 = mathlib::linalg::Vector<3, double>;
+
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+} // namespace
+
+TEST(MappedMatrix, ViewFeedsLinalgRoutines) {
+    const std::string mp = temp_path("mathlib_mapped_A.bin");
+    const std::string vp = temp_path("mathlib_mapped_b.bin");
+    const M3 A{ 4, 1, 0, 1, 3, 1, 0, 1, 2 };
+    const V3 b{ 1, 2, 3 };
+    mathlib::linalg::save_matrix(mp, A);
+    mathlib::linalg::save_vector(vp, b);
+
+    mathlib::linalg::mapped_matrix<3, 3, double> mA(mp);
+    mathlib::linalg::mapped_vector<3, double> mb(vp);
+    mA.advise(mathlib::linalg::mapped_matrix<3, 3, double>::access::sequential);
+
+    EXPECT_EQ(mA(1, 2), 1.0);
+    EXPECT_EQ(mb[2], 3.0);
+
+    const V3 x = mathlib::linalg::solve(mA.view(), mb.view());
+    const V3 r = mathlib::linalg::mul(mA.view(), x);
+    for (std::size_t i = 0; i < 3; ++i) EXPECT_NEAR(r[i], b[i], 1e-12);
+
+    const M3 At = mathlib::linalg::transpose<3, 3, double>(mA);
+    const M3 P = mA.view() * At;
+    EXPECT_EQ(P(0, 0), 17.0);
+
+    std::remove(mp.c_str());
+    std::remove(vp.c_str());
+}
+
+TEST(MappedMatrix, LargeMatrixFactorsWithoutStackCopy) {
+    // 256 x 256 doubles is 512 KiB: read in place, factor into heap storage
+    constexpr std::size_t N = 256;
+    const std::string mp = temp_path("mathlib_mapped_large.bin");
+    {
+        std::vector<double> a(N * N);
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < N; ++j) a[i * N + j] = (i == j) ? 4.0 : 1.0 / static_cast<double>(1 + i + j);
+        }
+        mathlib::linalg::save_matrix(mp, N, N, a.data());
+    }
+
+    mathlib::linalg::mapped_matrix<N, N, double> mA(mp);
+    auto lu = std::make_unique<mathlib::linalg::LU<N, double>>();
+    mathlib::linalg::lu_factor_into(mA.view(), *lu);
+
+    mathlib::linalg::Vector<N, double> b;
+    for (std::size_t i = 0; i < N; ++i) b[i] = static_cast<double>(i % 7);
+    const auto x = mathlib::linalg::lu_solve(*lu, b);
+    const auto r = mathlib::linalg::mul(mA.view(), x);
+    for (std::size_t i = 0; i < N; ++i) EXPECT_NEAR(r[i], b[i], 1e-12);
+
+    std::remove(mp.c_str());
+}
+
+TEST(MappedMatrix, CopyOnWriteLeavesFileUntouched) {
+    const std::string mp = temp_path("mathlib_mapped_cow.bin");
+    mathlib::linalg::save_matrix(mp, M3::identity());
+    {
+        mathlib::linalg::mapped_matrix<3, 3, double> m(mp, mathlib::core::mapped_file::mode::copy_on_write);
+        m.mutable_view()(0, 1) = 5.0;
+        EXPECT_EQ(m(0, 1), 5.0);
+    }
+    mathlib::linalg::mapped_matrix<3, 3, double> ro(mp);
+    EXPECT_EQ(ro(0, 1), 0.0);
+    EXPECT_THROW(ro.mutable_view(), mathlib::core::domain_error);
+    std::remove(mp.c_str());
+}
+
+TEST(MappedMatrix, SchemaChecks) {
+    const std::string mp = temp_path("mathlib_mapped_schema.bin");
+    // column-major 2 x 3 data is the row-major image of its 3 x 2 transpose
+    const std::vector<double> colmajor{ 1, 4, 2, 5, 3, 6 };
+    mathlib::linalg::save_matrix(mp, 2, 3, colmajor.data(), mathlib::linalg::matrix_layout::column_major);
+
+    EXPECT_THROW((mathlib::linalg::mapped_matrix<2, 3, double>(mp)), mathlib::core::dimension_error);
+    EXPECT_THROW((mathlib::linalg::mapped_matrix<3, 2, double>(mp)), mathlib::core::dimension_error);
+    EXPECT_THROW((mathlib::linalg::mapped_vector<6, float>(mp)), mathlib::core::dimension_error);
+    EXPECT_THROW((mathlib::linalg::mapped_vector<3, double>(temp_path("mathlib_mapped_missing.bin"))),
+        mathlib::core::io_error);
+
+    mathlib::linalg::save_matrix(mp, 3, 2, colmajor.data());
+    mathlib::linalg::mapped_matrix<3, 2, double> t(mp);
+    EXPECT_EQ(t(0, 1), 4.0);
+    EXPECT_EQ(t(2, 0), 3.0);
+    std::remove(mp.c_str());
+}
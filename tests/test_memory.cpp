@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <thread>
+
+#include "mathlib/core/memory.hpp"
+#include "mathlib/ode/solvers.hpp"
+#include "mathlib/ode/dense.hpp"
+
+namespace {
+
+    using V2 = mathlib::linalg::Vector<2, double>;
+
+    V2 oscillator(double, const V2& y) { return V2{ y[1], -y[0] }; }
+
+} // namespace
+
+TEST(Memory, CountingResourceTracksUpstream) {
+    mathlib::core::counting_resource counter;
+    {
+        std::pmr::vector<double> v(&counter);
+        v.resize(100);
+        EXPECT_EQ(counter.allocations(), 1u);
+        EXPECT_EQ(counter.bytes_in_use(), 100 * sizeof(double));
+    }
+    EXPECT_EQ(counter.deallocations(), 1u);
+    EXPECT_EQ(counter.bytes_in_use(), 0u);
+    EXPECT_EQ(counter.peak_bytes(), 100 * sizeof(double));
+}
+
+TEST(Memory, ArenaSteadyStateMakesNoUpstreamAllocations) {
+    mathlib::core::counting_resource upstream;
+    mathlib::core::request_arena arena(1024, &upstream); // deliberately too small at first
+
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-8;
+    auto request = [&] {
+        const auto traj = mathlib::ode::solve_rk45(oscillator, 0.0, V2{ 1.0, 0.0 }, 20.0, opt, &arena);
+        const auto fixed = mathlib::ode::solve_rk4(oscillator, 0.0, V2{ 1.0, 0.0 }, 1.0, 1e-2, &arena);
+        const auto dense = mathlib::ode::solve_rk45_dense(oscillator, 0.0, V2{ 1.0, 0.0 }, 5.0, opt, &arena);
+        EXPECT_NEAR(traj.back().second[0], std::cos(20.0), 1e-6);
+        EXPECT_NEAR(dense(2.5)[0], std::cos(2.5), 1e-6);
+        EXPECT_EQ(fixed.size(), 101u);
+    };
+
+    // warm-up requests let the arena grow to the working-set size
+    for (int i = 0; i < 3; ++i) {
+        request();
+        arena.reset();
+    }
+    const std::size_t before = upstream.allocations();
+    for (int i = 0; i < 100; ++i) {
+        request();
+        arena.reset();
+    }
+    EXPECT_EQ(upstream.allocations(), before);
+}
+
+TEST(Memory, ObserversAndThreadLocalPool) {
+    mathlib::core::counting_resource counter;
+    mathlib::ode::ring_buffer_observer<V2, double> ring(8, &counter);
+    EXPECT_EQ(counter.allocations(), 1u);
+    mathlib::ode::solve_rk4(oscillator, 0.0, V2{ 1.0, 0.0 }, 1.0, 0.01, ring);
+    EXPECT_EQ(ring.size(), 8u);
+    EXPECT_EQ(counter.allocations(), 1u);
+
+    std::pmr::memory_resource* main_pool = mathlib::core::thread_local_pool();
+    std::pmr::memory_resource* other_pool = nullptr;
+    std::thread([&] { other_pool = mathlib::core::thread_local_pool(); }).join();
+    EXPECT_NE(main_pool, other_pool);
+    EXPECT_EQ(main_pool, mathlib::core::thread_local_pool());
+
+    const auto traj = mathlib::ode::solve_euler(oscillator, 0.0, V2{ 1.0, 0.0 }, 1.0, 0.1, main_pool);
+    EXPECT_EQ(traj.get_allocator().resource(), main_pool);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+#include "mathlib/optimize/minimize.hpp"
+
+namespace {
+
+    using mathlib::linalg::Vector;
+
+    // Rosenbrock in N dimensions, minimum 0 at (1, ..., 1)
+    template <std::size_t N>
+    double rosenbrock(const Vector<N, double>& x) {
+        double s = 0.0;
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            const double a = x[i + 1] - x[i] * x[i];
+            const double b = 1.0 - x[i];
+            s += 100.0 * a * a + b * b;
+        }
+        return s;
+    }
+
+    template <std::size_t N>
+    Vector<N, double> rosenbrock_grad(const Vector<N, double>& x) {
+        Vector<N, double> g{};
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            const double a = x[i + 1] - x[i] * x[i];
+            g[i] += -400.0 * x[i] * a - 2.0 * (1.0 - x[i]);
+            g[i + 1] += 200.0 * a;
+        }
+        return g;
+    }
+
+} // namespace
+
+TEST(Minimize, LbfgsRosenbrockAnalyticGradient) {
+    constexpr std::size_t N = 6;
+    Vector<N, double> x0;
+    for (std::size_t i = 0; i < N; ++i) x0[i] = -1.2;
+
+    auto obj = mathlib::optimize::gradient_objective(rosenbrock<N>, rosenbrock_grad<N>);
+    auto r = mathlib::optimize::minimize_lbfgs(obj, x0);
+
+    ASSERT_TRUE(r.converged);
+    for (std::size_t i = 0; i < N; ++i) EXPECT_NEAR(r.x[i], 1.0, 1e-6);
+    EXPECT_EQ(r.f_evals, r.evaluations);
+    EXPECT_LT(r.evaluations, 200u);
+}
+
+TEST(Minimize, ConjugateGradientQuadratic) {
+    // f = sum i * (x_i - i)^2, gradient supplied together with f
+    constexpr std::size_t N = 5;
+    auto fg = [](const Vector<N, double>& x, Vector<N, double>& g) {
+        double f = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            const double w = static_cast<double>(i + 1);
+            const double d = x[i] - static_cast<double>(i);
+            f += w * d * d;
+            g[i] = 2.0 * w * d;
+        }
+        return f;
+        };
+
+    auto r = mathlib::optimize::minimize_cg(fg, Vector<N, double>{});
+    ASSERT_TRUE(r.converged);
+    for (std::size_t i = 0; i < N; ++i) EXPECT_NEAR(r.x[i], static_cast<double>(i), 1e-7);
+}
+
+TEST(Minimize, FiniteDifferenceCountsEvaluations) {
+    auto f = [](const Vector<2, double>& v) {
+        return (v[0] - 3.0) * (v[0] - 3.0) + 10.0 * (v[1] + 1.0) * (v[1] + 1.0);
+        };
+
+    auto r = mathlib::optimize::minimize(f, Vector<2, double>{ 0.0, 0.0 });
+    ASSERT_TRUE(r.converged);
+    EXPECT_NEAR(r.x[0], 3.0, 1e-6);
+    EXPECT_NEAR(r.x[1], -1.0, 1e-6);
+    // each gradient evaluation costs 2N + 1 = 5 calls of f
+    EXPECT_EQ(r.f_evals, 5 * r.evaluations);
+}
+
+TEST(Minimize, BoxConstrained) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    auto f = [](const Vector<2, double>& v) {
+        return (v[0] - 3.0) * (v[0] - 3.0) + (v[1] + 2.0) * (v[1] + 2.0);
+        };
+    auto grad = [](const Vector<2, double>& v) {
+        return Vector<2, double>{ 2.0 * (v[0] - 3.0), 2.0 * (v[1] + 2.0) };
+        };
+
+    mathlib::optimize::Bounds<2, double> box{ { -inf, 0.0 }, { 1.0, inf } };
+    auto r = mathlib::optimize::minimize_lbfgs(mathlib::optimize::gradient_objective(f, grad),
+        Vector<2, double>{ 0.5, 0.5 }, box);
+
+    ASSERT_TRUE(r.converged);
+    EXPECT_NEAR(r.x[0], 1.0, 1e-10);
+    EXPECT_NEAR(r.x[1], 0.0, 1e-10);
+}
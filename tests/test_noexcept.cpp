@@ -0,0 +1,152 @@
+// Built with exceptions disabled (see CMakeLists.txt): every header must
+// compile this way, and the try_* variants must report failures as values.
+#include <gtest/gtest.h>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "mathlib/core/error.hpp"
+#include "mathlib/core/executor.hpp"
+#include "mathlib/core/expected.hpp"
+#include "mathlib/core/instrument.hpp"
+#include "mathlib/core/mapped_file.hpp"
+#include "mathlib/core/memory.hpp"
+#include "mathlib/calculus/diff.hpp"
+#include "mathlib/calculus/grad.hpp"
+#include "mathlib/calculus/integrate.hpp"
+#include "mathlib/calculus/integrate_vec.hpp"
+#include "mathlib/calculus/jacobian.hpp"
+#include "mathlib/calculus/nonlinear.hpp"
+#include "mathlib/calculus/root.hpp"
+#include "mathlib/linalg/lu.hpp"
+#include "mathlib/linalg/mapped.hpp"
+#include "mathlib/linalg/solve.hpp"
+#include "mathlib/ode/dense.hpp"
+#include "mathlib/ode/ensemble.hpp"
+#include "mathlib/ode/solvers.hpp"
+#include "mathlib/ode/stiff.hpp"
+#include "mathlib/ode/symplectic.hpp"
+#include "mathlib/ode/trajectory_file.hpp"
+#include "mathlib/optimize/minimize.hpp"
+
+using mathlib::core::error_code;
+using mathlib::linalg::Matrix;
+using mathlib::linalg::Vector;
+
+static_assert(!MATHLIB_HAS_EXCEPTIONS);
+
+TEST(NoExcept, TrySolve) {
+    Matrix<2, 2, double> A{ 2.0, 1.0, 1.0, 3.0 };
+    Vector<2, double> b{ 3.0, 5.0 };
+    static_assert(noexcept(mathlib::linalg::try_solve(A, b)));
+
+    auto x = mathlib::linalg::try_solve(A, b);
+    ASSERT_TRUE(x.has_value());
+    EXPECT_NEAR((*x)[0], 0.8, 1e-12);
+    EXPECT_NEAR((*x)[1], 1.4, 1e-12);
+
+    Matrix<2, 2, double> S{ 1.0, 2.0, 2.0, 4.0 };
+    mathlib::core::basic_stats st;
+    auto bad = mathlib::linalg::try_solve(S, b, 1e-12, st);
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error(), error_code::singular_matrix);
+    EXPECT_EQ(st.iterations, 1u); // first column eliminated before the zero pivot
+}
+
+TEST(NoExcept, TryRoots) {
+    auto f = [](double x) { return x * x - 2.0; };
+    static_assert(noexcept(mathlib::calculus::try_root_newton(f, 1.0)));
+
+    auto r = mathlib::calculus::try_root_newton(f, 1.0);
+    ASSERT_TRUE(r);
+    EXPECT_NEAR(*r, std::sqrt(2.0), 1e-10);
+
+    auto flat = mathlib::calculus::try_root_newton([](double) { return 1.0; }, 0.0);
+    ASSERT_FALSE(flat);
+    EXPECT_EQ(flat.error(), error_code::zero_derivative);
+
+    auto bad_eps = mathlib::calculus::try_root_newton(f, 1.0, -1.0);
+    EXPECT_EQ(bad_eps.error(), error_code::invalid_argument);
+
+    auto br = mathlib::calculus::try_root_bisection(f, 0.0, 2.0);
+    ASSERT_TRUE(br);
+    EXPECT_NEAR(*br, std::sqrt(2.0), 1e-10);
+
+    auto unbracketed = mathlib::calculus::try_root_bisection(f, 2.0, 3.0);
+    ASSERT_FALSE(unbracketed);
+    EXPECT_EQ(unbracketed.error(), error_code::no_sign_change);
+
+    // running out of iterations is reported through stats, not as an error
+    mathlib::core::basic_stats st;
+    auto partial = mathlib::calculus::try_root_bisection(f, 0.0, 2.0, 1e-12, 5, st);
+    ASSERT_TRUE(partial);
+    EXPECT_FALSE(st.converged);
+}
+
+TEST(NoExcept, TryIntegrate) {
+    auto f = [](double x) { return std::sin(x); };
+    const double pi = std::acos(-1.0);
+
+    auto s = mathlib::calculus::try_integrate_simpson(f, 0.0, pi, 100);
+    ASSERT_TRUE(s);
+    EXPECT_NEAR(*s, 2.0, 1e-7);
+    EXPECT_EQ(mathlib::calculus::try_integrate_simpson(f, 0.0, pi, 1).error(), error_code::invalid_argument);
+
+    auto a = mathlib::calculus::try_integrate_adaptive_simpson(f, 0.0, pi);
+    ASSERT_TRUE(a);
+    EXPECT_NEAR(*a, 2.0, 1e-9);
+    EXPECT_EQ(mathlib::calculus::try_integrate_adaptive_simpson(f, 0.0, pi, 0.0).error(),
+        error_code::invalid_argument);
+
+    mathlib::core::basic_stats st;
+    auto shallow = mathlib::calculus::try_integrate_adaptive_simpson(f, 0.0, pi, 1e-14, 2, st);
+    ASSERT_TRUE(shallow);
+    EXPECT_FALSE(st.converged);
+    EXPECT_GT(st.rejected, 0u);
+}
+
+TEST(NoExcept, TrySolveRk45) {
+    auto decay = [](double, double y) { return -y; };
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-9;
+    opt.atol = 1e-12;
+
+    std::size_t seen = 0;
+    mathlib::ode::Rk45Stats st;
+    auto r = mathlib::ode::try_solve_rk45(decay, 0.0, 1.0, 1.0, opt,
+        [&seen](double, double) { ++seen; }, &st);
+    ASSERT_TRUE(r);
+    EXPECT_DOUBLE_EQ(r->first, 1.0);
+    EXPECT_NEAR(r->second, std::exp(-1.0), 1e-8);
+    EXPECT_EQ(seen, st.accepted + 1);
+
+    auto traj = mathlib::ode::try_solve_rk45(decay, 0.0, 1.0, 1.0, opt);
+    ASSERT_TRUE(traj);
+    EXPECT_EQ(traj->back().first, 1.0);
+
+    mathlib::ode::Rk45Options<double> bad = opt;
+    bad.rtol = bad.atol = 0.0;
+    EXPECT_EQ(mathlib::ode::try_solve_rk45(decay, 0.0, 1.0, 1.0, bad).error(), error_code::invalid_argument);
+
+    // y' = y^2 blows up at t = 1; the controller stalls before t1
+    mathlib::ode::Rk45Options<double> blow = opt;
+    blow.h_min = 1e-8;
+    seen = 0;
+    auto fail = mathlib::ode::try_solve_rk45([](double, double y) { return y * y; }, 0.0, 1.0, 2.0, blow,
+        [&seen](double, double) { ++seen; }, &st);
+    ASSERT_FALSE(fail);
+    EXPECT_EQ(fail.error(), error_code::step_underflow);
+    EXPECT_GT(st.accepted, 0u); // partial progress is still visible
+    EXPECT_EQ(seen, st.accepted + 1);
+
+    mathlib::ode::Rk45Options<double> capped = opt;
+    capped.max_steps = 3;
+    EXPECT_EQ(mathlib::ode::try_solve_rk45(decay, 0.0, 1.0, 10.0, capped).error(), error_code::too_many_steps);
+}
+
+TEST(NoExcept, ThreadPoolWithoutExceptions) {
+    mathlib::core::thread_pool pool(2);
+    auto f = [](double x) { return x * x; };
+    const double v = mathlib::calculus::integrate_simpson(pool, f, 0.0, 1.0, 100000);
+    EXPECT_NEAR(v, 1.0 / 3.0, 1e-12);
+}
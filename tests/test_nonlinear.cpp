@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+#include "mathlib/calculus/grad.hpp"
+#include "mathlib/calculus/nonlinear.hpp"
+#include "mathlib/linalg/lu.hpp"
+#include "mathlib/linalg/solve.hpp"
+#include "mathlib/core/almost_equal.hpp"
+
+TEST(LinalgLU, FactorOnceSolveMany) {
+    using namespace mathlib::linalg;
+    using mathlib::core::almost_equal;
+
+    Matrix<3, 3, double> A{
+      3, 2, -1,
+      2, -2, 4,
+      -1, 0.5, -1
+    };
+    auto f = lu_factor(A);
+
+    Vector<3, double> b1{ 1, -2, 0 };
+    Vector<3, double> b2{ 4, 0, 1 };
+    auto x1 = lu_solve(f, b1);
+    auto x2 = lu_solve(f, b2);
+    auto s1 = solve(A, b1);
+    auto s2 = solve(A, b2);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(almost_equal(x1[i], s1[i], 1e-12, 1e-12));
+        EXPECT_TRUE(almost_equal(x2[i], s2[i], 1e-12, 1e-12));
+    }
+
+    Matrix<2, 2, double> S{ 1, 2, 2, 4 };
+    EXPECT_THROW((void)lu_factor(S), mathlib::core::domain_error);
+}
+
+TEST(NonlinearSolve, CircleAndExponential) {
+    using mathlib::linalg::Vector;
+
+    // x^2 + y^2 = 4, e^x + y = 1
+    auto F = [](const Vector<2, double>& v) {
+        return Vector<2, double>{ v[0] * v[0] + v[1] * v[1] - 4.0, std::exp(v[0]) + v[1] - 1.0 };
+        };
+
+    auto r = mathlib::calculus::solve_nonlinear(F, Vector<2, double>{ 1.0, -1.7 });
+
+    ASSERT_TRUE(r.converged);
+    auto fx = F(r.x);
+    EXPECT_LT(std::abs(fx[0]), 1e-9);
+    EXPECT_LT(std::abs(fx[1]), 1e-9);
+}
+
+TEST(NonlinearSolve, BroydenTridiagonalFewEvaluations) {
+    using mathlib::linalg::Vector;
+    constexpr std::size_t N = 8;
+
+    // Broyden tridiagonal function: (3 - 2x_i) x_i - x_{i-1} - 2 x_{i+1} + 1 = 0
+    auto F = [](const Vector<N, double>& x) {
+        Vector<N, double> out;
+        for (std::size_t i = 0; i < N; ++i) {
+            double xm = (i > 0) ? x[i - 1] : 0.0;
+            double xp = (i + 1 < N) ? x[i + 1] : 0.0;
+            out[i] = (3.0 - 2.0 * x[i]) * x[i] - xm - 2.0 * xp + 1.0;
+        }
+        return out;
+        };
+
+    Vector<N, double> x0;
+    for (std::size_t i = 0; i < N; ++i) x0[i] = -1.0;
+
+    std::size_t evals = 0;
+    auto counted = [&](const Vector<N, double>& x) { ++evals; return F(x); };
+    auto r = mathlib::calculus::solve_nonlinear(counted, x0);
+    ASSERT_TRUE(r.converged);
+    EXPECT_LT(r.f_norm, 1e-10);
+    EXPECT_EQ(r.f_evals, evals);
+    EXPECT_LE(r.jacobian_evals, r.iterations);
+
+    // The hand-rolled loop this replaces: every iteration builds the Jacobian
+    // row by row with gradient() (2N evaluations per row) and calls solve().
+    std::size_t newton_evals = 0;
+    Vector<N, double> x = x0;
+    for (int it = 0; it < 50; ++it) {
+        const auto fx = F(x);
+        ++newton_evals;
+        double m = 0;
+        for (std::size_t i = 0; i < N; ++i) m = std::max(m, std::abs(fx[i]));
+        if (m <= 1e-10) break;
+        mathlib::linalg::Matrix<N, N, double> J;
+        for (std::size_t i = 0; i < N; ++i) {
+            const auto row = mathlib::calculus::gradient([&](const Vector<N, double>& v) {
+                ++newton_evals;
+                return F(v)[i];
+                }, x);
+            for (std::size_t j = 0; j < N; ++j) J(i, j) = row[j];
+        }
+        x = x - mathlib::linalg::solve(J, fx);
+    }
+    for (std::size_t i = 0; i < N; ++i) EXPECT_NEAR(x[i], r.x[i], 1e-8);
+    EXPECT_LE(10 * r.f_evals, newton_evals) << r.f_evals << " vs " << newton_evals;
+}
+
+TEST(NonlinearSolve, StalledLineSearchIsNotConverged) {
+    using mathlib::linalg::Vector;
+    using mathlib::linalg::Matrix;
+
+    // x^2 + 1 has no real root: Newton's direction is always a descent
+    // direction for |F|^2, but the accepted steps shrink towards x = 0
+    // where |F| stays 1. With a loose tol_x the small-step exit is reached.
+    auto F = [](const Vector<1, double>& v) { return Vector<1, double>{ v[0] * v[0] + 1.0 }; };
+    auto J = [](const Vector<1, double>& v) { return Matrix<1, 1, double>{ 2.0 * v[0] }; };
+
+    mathlib::calculus::NonlinearOptions<double> opt;
+    opt.tol_x = 1e-2;
+    auto r = mathlib::calculus::solve_nonlinear(F, J, Vector<1, double>{ 0.1 }, opt);
+    EXPECT_FALSE(r.converged);
+    EXPECT_TRUE(r.stagnated);
+    EXPECT_GT(r.f_norm, 0.99);
+}
+
+TEST(NonlinearSolve, UserJacobian) {
+    using mathlib::linalg::Vector;
+    using mathlib::linalg::Matrix;
+
+    auto F = [](const Vector<2, double>& v) {
+        return Vector<2, double>{ v[0] * v[0] - 2.0, v[0] * v[1] - 1.0 };
+        };
+    auto J = [](const Vector<2, double>& v) {
+        return Matrix<2, 2, double>{ 2.0 * v[0], 0.0, v[1], v[0] };
+        };
+
+    mathlib::calculus::NonlinearOptions<double> opt;
+    opt.broyden = false;
+    auto r = mathlib::calculus::solve_nonlinear(F, J, Vector<2, double>{ 1.0, 1.0 }, opt);
+
+    ASSERT_TRUE(r.converged);
+    EXPECT_NEAR(r.x[0], std::sqrt(2.0), 1e-10);
+    EXPECT_NEAR(r.x[1], 1.0 / std::sqrt(2.0), 1e-10);
+    EXPECT_GE(r.jacobian_evals, 1u);
+}
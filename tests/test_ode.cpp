@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include "mathlib/ode/solvers.hpp"
+#include "mathlib/ode/observers.hpp"
+#include "mathlib/ode/dense.hpp"
+#include "mathlib/linalg/vector.hpp"
+
+TEST(ODEObservers, FinalStateMatchesTrajectory) {
+    using mathlib::linalg::Vector;
+    // harmonic oscillator
+    auto f = [](double, const Vector<2, double>& y) { return Vector<2, double>{ y[1], -y[0] }; };
+    Vector<2, double> y0{ 1.0, 0.0 };
+
+    auto traj = mathlib::ode::solve_rk4(f, 0.0, y0, 2.0, 1e-3);
+    mathlib::ode::final_state_observer<Vector<2, double>, double> last;
+    auto [t, y] = mathlib::ode::solve_rk4(f, 0.0, y0, 2.0, 1e-3, last);
+
+    EXPECT_EQ(last.samples, traj.size());
+    EXPECT_EQ(t, traj.back().first);
+    EXPECT_EQ(y[0], traj.back().second[0]);
+    EXPECT_EQ(last.y[1], traj.back().second[1]);
+}
+
+TEST(ODEObservers, DecimateAndRingBuffer) {
+    auto f = [](double, double y) { return -y; };
+
+    std::vector<double> kept;
+    auto every10 = mathlib::ode::decimate(10, [&](double t, double) { kept.push_back(t); });
+    mathlib::ode::solve_euler(f, 0.0, 1.0, 1.0, 0.01, every10);
+    ASSERT_EQ(kept.size(), 11u); // 101 samples -> 0, 10, ..., 100
+    EXPECT_NEAR(kept[1], 0.1, 1e-12);
+
+    mathlib::ode::ring_buffer_observer<double, double> ring(5);
+    auto [t, y] = mathlib::ode::solve_euler(f, 0.0, 1.0, 1.0, 0.01, ring);
+    ASSERT_EQ(ring.size(), 5u);
+    EXPECT_EQ(ring[4].first, t);
+    EXPECT_EQ(ring[4].second, y);
+    EXPECT_LT(ring[0].first, ring[1].first);
+}
+
+TEST(ODEObservers, SampleAtFixedTimes) {
+    auto f = [](double, double y) { return y; };
+
+    std::vector<std::pair<double, double>> out;
+    auto sampler = mathlib::ode::sample_at<double, double>({ 0.0, 0.25, 0.5, 1.0 },
+        [&](double t, double y) { out.push_back({ t, y }); });
+    mathlib::ode::solve_rk45(f, 0.0, 1.0, 1.0, sampler, 1e-2, 1e-10);
+
+    ASSERT_EQ(out.size(), 4u);
+    // linear interpolation between adaptive steps
+    for (auto& [t, y] : out) EXPECT_NEAR(y, std::exp(t), 1e-3);
+}
+
+TEST(ODEObservers, EarlyStop) {
+    auto f = [](double, double y) { return y; };
+
+    // stop once y exceeds 2
+    auto [t, y] = mathlib::ode::solve_rk45(f, 0.0, 1.0, 10.0, [](double, double y) { return y < 2.0; });
+    EXPECT_GE(y, 2.0);
+    EXPECT_LT(t, 1.0);
+}
+
+TEST(Dopri5, FsalCostsSixEvaluationsPerAcceptedStep) {
+    using mathlib::linalg::Vector;
+    auto f = [](double, const Vector<2, double>& y) { return Vector<2, double>{ y[1], -y[0] }; };
+
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-8;
+    opt.atol = 1e-10;
+    mathlib::ode::Rk45Stats st;
+    auto [t, y] = mathlib::ode::solve_rk45(f, 0.0, Vector<2, double>{ 1.0, 0.0 }, 10.0, opt,
+        [](double, const Vector<2, double>&) {}, &st);
+
+    EXPECT_EQ(t, 10.0);
+    EXPECT_NEAR(y[0], std::cos(10.0), 1e-6);
+    EXPECT_NEAR(y[1], -std::sin(10.0), 1e-6);
+    // initial k1 + one probe for the automatic h0, then 6 per attempted step
+    EXPECT_EQ(st.f_evals, 2 + 6 * (st.accepted + st.rejected));
+}
+
+TEST(Dopri5, LegacySignatureUsesMaxNorm) {
+    // eps bounds every component of the error estimate, as it did before the
+    // options overload; an RMS norm over 8 components would allow up to sqrt(8) eps
+    using V = mathlib::linalg::Vector<8, double>;
+    auto f = [](double, const V& y) {
+        V d;
+        for (std::size_t i = 0; i < 8; i += 2) {
+            d[i] = y[i + 1];
+            d[i + 1] = -y[i];
+        }
+        return d;
+    };
+    V y0;
+    for (std::size_t i = 0; i < 8; i += 2) y0[i] = 1.0;
+
+    const auto legacy = mathlib::ode::solve_rk45(f, 0.0, y0, 10.0, 1e-2, 1e-8);
+
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 0.0;
+    opt.atol = 1e-8;
+    opt.h0 = 1e-2;
+    opt.h_min = 1e-10;
+    opt.h_max = 1.0;
+    opt.norm = mathlib::ode::rk45_norm::max;
+    const auto with_max = mathlib::ode::solve_rk45(f, 0.0, y0, 10.0, opt);
+    opt.norm = mathlib::ode::rk45_norm::rms;
+    const auto with_rms = mathlib::ode::solve_rk45(f, 0.0, y0, 10.0, opt);
+
+    ASSERT_EQ(legacy.size(), with_max.size());
+    EXPECT_EQ(legacy.back().second[0], with_max.back().second[0]);
+    EXPECT_GT(with_max.size(), with_rms.size());
+}
+
+TEST(Dopri5, MixedTolerancesAndStepUnderflow) {
+    // y' = -50 (y - cos t): relative tolerance on a component that grows large
+    auto f = [](double t, double y) { return -50.0 * (y - std::cos(t)); };
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-6;
+    opt.atol = 1e-12;
+    auto traj = mathlib::ode::solve_rk45(f, 0.0, 0.0, 2.0, opt);
+    const double exact_tail = (2500.0 * std::cos(2.0) + 50.0 * std::sin(2.0)) / 2501.0;
+    EXPECT_NEAR(traj.back().second, exact_tail, 1e-5);
+
+    opt.h_min = 1.0; // the stiff transient cannot be crossed with h >= 1
+    EXPECT_THROW((void)mathlib::ode::solve_rk45(f, 0.0, 0.0, 2.0, opt), mathlib::core::domain_error);
+}
+
+TEST(DenseOutput, InterpolantAccuracyAndLookup) {
+    using mathlib::linalg::Vector;
+    auto f = [](double, const Vector<2, double>& y) { return Vector<2, double>{ y[1], -y[0] }; };
+
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-9;
+    opt.atol = 1e-12;
+    auto sol = mathlib::ode::solve_rk45_dense(f, 0.0, Vector<2, double>{ 1.0, 0.0 }, 10.0, opt);
+
+    ASSERT_GT(sol.size(), 1u);
+    EXPECT_EQ(sol.t_end(), 10.0);
+    for (int i = 0; i <= 1000; ++i) {
+        const double t = 0.01 * i;
+        auto y = sol(t);
+        EXPECT_NEAR(y[0], std::cos(t), 1e-7);
+        EXPECT_NEAR(y[1], -std::sin(t), 1e-7);
+    }
+}
+
+TEST(DenseOutput, ReportTimesDoNotCostSteps) {
+    auto f = [](double, double y) { return -y; };
+    mathlib::ode::Rk45Options<double> opt;
+    opt.rtol = 1e-8;
+    opt.atol = 1e-12;
+
+    std::vector<double> times;
+    for (int i = 0; i <= 10000; ++i) times.push_back(5.0 * i / 10000.0);
+
+    mathlib::ode::Rk45Stats dense_stats, plain_stats;
+    double max_err = 0.0;
+    std::size_t reported = 0;
+    mathlib::ode::solve_rk45_at(f, 0.0, 1.0, times, opt, [&](double t, double y) {
+        max_err = std::max(max_err, std::abs(y - std::exp(-t)));
+        ++reported;
+        }, &dense_stats);
+    (void)mathlib::ode::solve_rk45(f, 0.0, 1.0, 5.0, opt, &plain_stats);
+
+    EXPECT_EQ(reported, times.size());
+    EXPECT_LT(max_err, 1e-7);
+    EXPECT_EQ(dense_stats.f_evals, plain_stats.f_evals);
+}
+
+TEST(DenseOutput, EventLocation) {
+    using mathlib::linalg::Vector;
+    // ball thrown up at 10 m/s, g = 9.81: hits the ground at t = 2 * 10 / 9.81
+    auto f = [](double, const Vector<2, double>& y) { return Vector<2, double>{ y[1], -9.81 }; };
+    auto ground = [](double, const Vector<2, double>& y) { return y[0]; };
+
+    // starting exactly on the surface is not itself an event
+    auto ev = mathlib::ode::solve_rk45_until(f, ground, 0.0, Vector<2, double>{ 0.0, 10.0 }, 100.0);
+    ASSERT_TRUE(ev.triggered);
+    EXPECT_NEAR(ev.t, 20.0 / 9.81, 1e-9);
+    EXPECT_NEAR(ev.y[1], -10.0, 1e-8);
+}
+
+TEST(DenseOutput, EventTimeDoesNotDependOnUnitsOfG) {
+    using mathlib::linalg::Vector;
+    auto f = [](double, const Vector<2, double>& y) { return Vector<2, double>{ y[1], -9.81 }; };
+    for (double s : { 1.0, 1e-12, 1e-15, 1e-17, 1e12 }) {
+        auto ground = [s](double, const Vector<2, double>& y) { return s * y[0]; };
+        auto ev = mathlib::ode::solve_rk45_until(f, ground, 0.0, Vector<2, double>{ 1e-12, 10.0 }, 100.0);
+        ASSERT_TRUE(ev.triggered) << s;
+        EXPECT_NEAR(ev.t, 20.0 / 9.81, 1e-9) << s;
+        EXPECT_NEAR(ev.y[0], 0.0, 1e-9) << s;
+    }
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "mathlib/core/reduce.hpp"
+#include "mathlib/calculus/integrate.hpp"
+#include "mathlib/calculus/integrate_vec.hpp"
+#include "mathlib/linalg/matrix.hpp"
+#include "mathlib/linalg/solve.hpp"
+#include "mathlib/linalg/vector.hpp"
+
+using mathlib::core::neumaier_sum;
+using mathlib::core::reduce_sum;
+
+static_assert(reduce_sum(1000, [](std::size_t i) { return static_cast<long>(i); }) == 499500);
+static_assert(reduce_sum(3, [](std::size_t i) { return 0.5 * static_cast<double>(i); }, neumaier_sum{}) == 1.5);
+
+namespace {
+
+    // naive left-to-right sum, for comparison
+    double serial_sum(const std::vector<float>& x) {
+        float s = 0;
+        for (float v : x) s += v;
+        return s;
+    }
+
+} // namespace
+
+TEST(Reduce, EveryTermOnceInOrder) {
+    for (std::size_t n : { 0u, 1u, 7u, 8u, 9u, 127u, 128u, 129u, 1000u, 4097u }) {
+        std::size_t next = 0;
+        bool in_order = true;
+        const std::size_t total = reduce_sum(n, [&](std::size_t i) {
+            in_order = in_order && i == next++;
+            return i;
+            });
+        EXPECT_TRUE(in_order) << n;
+        EXPECT_EQ(next, n);
+        EXPECT_EQ(total, n * (n - 1) / 2) << n;
+    }
+}
+
+TEST(Reduce, PairwiseErrorGrowsSlowly) {
+    // 0.1f summed 2^22 times: a single float accumulator stalls long before
+    // the end, pairwise stays within a few ulp
+    const std::size_t n = std::size_t{ 1 } << 22;
+    std::vector<float> x(n, 0.1f);
+    const double exact = 0.1f * static_cast<double>(n);
+
+    const float pairwise = reduce_sum(n, [&](std::size_t i) { return x[i]; });
+    EXPECT_LT(std::abs(pairwise - exact) / exact, 1e-6);
+    EXPECT_GT(std::abs(serial_sum(x) - exact) / exact, 1e-2);
+
+    const float compensated = reduce_sum(n, [&](std::size_t i) { return x[i]; }, neumaier_sum{});
+    EXPECT_EQ(compensated, static_cast<float>(exact));
+}
+
+TEST(Reduce, NeumaierRecoversCancellation) {
+    const double terms[] = { 1.0, 1e100, 1.0, -1e100 };
+    EXPECT_EQ(reduce_sum(4, [&](std::size_t i) { return terms[i]; }, neumaier_sum{}), 2.0);
+
+    const double a[] = { 1e16, 1.0, -1e16, 1.0, 3.0 };
+    const double b[] = { 1.0, 1.0, 1.0, 1.0, 1.0 };
+    EXPECT_EQ(mathlib::core::reduce_dot(a, b, 5, 1, 1, neumaier_sum{}), 5.0);
+}
+
+TEST(Reduce, LinalgUsesPairwise) {
+    // small fixed sizes keep the plain left-to-right order
+    mathlib::linalg::Vector<3, double> u{ 1e16, 1.0, -1e16 };
+    mathlib::linalg::Vector<3, double> ones{ 1.0, 1.0, 1.0 };
+    EXPECT_EQ(dot(u, ones), (1e16 + 1.0) - 1e16);
+
+    constexpr std::size_t N = 512;
+    mathlib::linalg::Vector<N, float> v;
+    for (std::size_t i = 0; i < N; ++i) v[i] = 1.0f + static_cast<float>(i % 7) * 1e-3f;
+    double exact = 0;
+    for (std::size_t i = 0; i < N; ++i) exact += static_cast<double>(v[i]) * v[i];
+    EXPECT_NEAR(v.norm2(), exact, 1e-6 * exact);
+
+    constexpr std::size_t M = 64;
+    mathlib::linalg::Matrix<M, M, double> A, B;
+    for (std::size_t i = 0; i < M * M; ++i) {
+        A.a[i] = std::sin(static_cast<double>(i));
+        B.a[i] = std::cos(static_cast<double>(i));
+    }
+    const auto C = A * B;
+    mathlib::linalg::Vector<M, double> x;
+    for (std::size_t i = 0; i < M; ++i) x[i] = static_cast<double>(i) / M;
+    const auto Ax = mathlib::linalg::mul(A, x);
+    for (std::size_t r = 0; r < M; ++r) {
+        double row = 0, c0 = 0;
+        for (std::size_t k = 0; k < M; ++k) {
+            row += A(r, k) * x[k];
+            c0 += A(r, k) * B(k, 0);
+        }
+        EXPECT_NEAR(Ax[r], row, 1e-12);
+        EXPECT_NEAR(C(r, 0), c0, 1e-12);
+    }
+}
+
+TEST(Reduce, SimpsonLargeN) {
+    // constant integrand: the only error is summation error
+    auto one = [](float) { return 1.0f; };
+    const std::size_t n = 2'000'000;
+    EXPECT_NEAR(mathlib::calculus::integrate_simpson(one, 0.0f, 3.0f, n), 3.0f, 3e-6f);
+    EXPECT_NEAR(mathlib::calculus::integrate_simpson(one, 0.0f, 3.0f, n, neumaier_sum{}), 3.0f, 1e-6f);
+
+    auto vf = [](float x) { return mathlib::linalg::Vector<2, float>{ 1.0f, x }; };
+    const auto r = mathlib::calculus::integrate_simpson_vec<decltype(vf), 2, float>(vf, 0.0f, 2.0f, n);
+    EXPECT_NEAR(r[0], 2.0f, 4e-6f);
+    EXPECT_NEAR(r[1], 2.0f, 4e-6f);
+}
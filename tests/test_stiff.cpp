@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "mathlib/ode/stiff.hpp"
+#include "mathlib/ode/solvers.hpp"
+#include "mathlib/calculus/jacobian.hpp"
+
+namespace {
+
+    using V3 = mathlib::linalg::Vector<3, double>;
+
+    // Robertson chemical kinetics (stiffness ratio ~1e11)
+    V3 robertson(double, const V3& y) {
+        return V3{
+            -0.04 * y[0] + 1e4 * y[1] * y[2],
+            0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1],
+            3e7 * y[1] * y[1]
+        };
+    }
+
+    mathlib::linalg::Matrix<3, 3, double> robertson_jac(double, const V3& y) {
+        return mathlib::linalg::Matrix<3, 3, double>{
+            -0.04, 1e4 * y[2], 1e4 * y[1],
+            0.04, -1e4 * y[2] - 6e7 * y[1], -1e4 * y[1],
+            0.0, 6e7 * y[1], 0.0
+        };
+    }
+
+    void expect_robertson_t40(const V3& y) {
+        // reference values (Hairer & Wanner, Solving ODEs II)
+        EXPECT_NEAR(y[0], 0.7158270687, 1e-4);
+        EXPECT_NEAR(y[1], 9.185534764e-06, 1e-8);
+        EXPECT_NEAR(y[2], 0.2841637457, 1e-4);
+    }
+
+} // namespace
+
+TEST(StiffODE, RosenbrockRobertson) {
+    mathlib::ode::StiffOptions<double> opt;
+    opt.rtol = 1e-6;
+    opt.atol = 1e-10;
+    mathlib::ode::StiffStats st;
+    auto traj = mathlib::ode::solve_rosenbrock23(robertson, robertson_jac, 0.0, V3{ 1.0, 0.0, 0.0 }, 40.0, opt, &st);
+
+    expect_robertson_t40(traj.back().second);
+    EXPECT_LT(st.accepted, 2000u);
+}
+
+TEST(StiffODE, RosenbrockEvaluationCount) {
+    // two stage evaluations per attempt (FSAL); df/dt costs one more per
+    // accepted step unless the system is declared autonomous. The oversized
+    // h0 forces rejected attempts, which must not re-evaluate df/dt.
+    mathlib::ode::StiffOptions<double> opt;
+    opt.rtol = 1e-6;
+    opt.atol = 1e-10;
+    opt.h0 = 1.0;
+    mathlib::ode::StiffStats st;
+    auto y = mathlib::ode::solve_rosenbrock23(robertson, robertson_jac, 0.0, V3{ 1.0, 0.0, 0.0 }, 40.0, opt,
+        [](double, const V3&) {}, &st).second;
+    expect_robertson_t40(y);
+    EXPECT_GT(st.rejected, 0u);
+    EXPECT_EQ(st.f_evals, 1 + 2 * (st.accepted + st.rejected) + st.accepted);
+
+    opt.autonomous = true;
+    mathlib::ode::StiffStats sa;
+    y = mathlib::ode::solve_rosenbrock23(robertson, robertson_jac, 0.0, V3{ 1.0, 0.0, 0.0 }, 40.0, opt,
+        [](double, const V3&) {}, &sa).second;
+    expect_robertson_t40(y);
+    EXPECT_EQ(sa.f_evals, 1 + 2 * (sa.accepted + sa.rejected));
+}
+
+TEST(StiffODE, BdfRobertsonReusesFactorization) {
+    mathlib::ode::StiffOptions<double> opt;
+    opt.rtol = 1e-6;
+    opt.atol = 1e-10;
+    mathlib::ode::StiffStats st;
+    auto traj = mathlib::ode::solve_bdf(robertson, mathlib::ode::finite_difference_jacobian{},
+        0.0, V3{ 1.0, 0.0, 0.0 }, 40.0, opt, &st);
+
+    expect_robertson_t40(traj.back().second);
+    EXPECT_LT(st.accepted, 1000u);
+    EXPECT_LT(st.jacobian_evals, st.accepted / 2);
+    EXPECT_LT(st.lu_decompositions, st.accepted);
+}
+
+TEST(StiffODE, BandedJacobianHeatEquation) {
+    constexpr std::size_t N = 16;
+    using V = mathlib::linalg::Vector<N, double>;
+    const double dx = 1.0 / (N + 1);
+    const double pi = 3.14159265358979323846;
+
+    // 1D heat equation, Dirichlet boundaries: tridiagonal Jacobian
+    auto f = [dx](double, const V& u) {
+        V out;
+        for (std::size_t i = 0; i < N; ++i) {
+            const double l = i > 0 ? u[i - 1] : 0.0;
+            const double r = i + 1 < N ? u[i + 1] : 0.0;
+            out[i] = (l - 2.0 * u[i] + r) / (dx * dx);
+        }
+        return out;
+        };
+
+    V u0;
+    for (std::size_t i = 0; i < N; ++i) u0[i] = std::sin(pi * (i + 1) * dx);
+    const double lambda = -(2.0 - 2.0 * std::cos(pi * dx)) / (dx * dx);
+
+    mathlib::ode::StiffOptions<double> opt;
+    opt.rtol = 1e-7;
+    opt.atol = 1e-10;
+    opt.lower_bandwidth = 1;
+    opt.upper_bandwidth = 1;
+
+    mathlib::ode::StiffStats banded, dense;
+    auto yb = mathlib::ode::solve_bdf(f, mathlib::ode::finite_difference_jacobian{}, 0.0, u0, 0.2, opt, &banded);
+    for (std::size_t i = 0; i < N; ++i) EXPECT_NEAR(yb.back().second[i], std::exp(lambda * 0.2) * u0[i], 1e-5);
+
+    auto yr = mathlib::ode::solve_rosenbrock23(f, mathlib::ode::finite_difference_jacobian{}, 0.0, u0, 0.2, opt);
+    for (std::size_t i = 0; i < N; ++i) EXPECT_NEAR(yr.back().second[i], std::exp(lambda * 0.2) * u0[i], 1e-5);
+
+    opt.lower_bandwidth = opt.upper_bandwidth = N;
+    (void)mathlib::ode::solve_bdf(f, mathlib::ode::finite_difference_jacobian{}, 0.0, u0, 0.2, opt, &dense);
+    // 3 evaluations per banded Jacobian instead of 16
+    EXPECT_LT(banded.f_evals, dense.f_evals);
+}
+
+TEST(StiffODE, BandedFiniteDifferenceMatchesDense) {
+    using V = mathlib::linalg::Vector<5, double>;
+    auto F = [](const V& x) {
+        V out;
+        for (std::size_t i = 0; i < 5; ++i) {
+            out[i] = x[i] * x[i] + (i > 0 ? 2.0 * x[i - 1] : 0.0) - (i + 1 < 5 ? std::sin(x[i + 1]) : 0.0);
+        }
+        return out;
+        };
+    V x{ 0.1, 0.2, 0.3, 0.4, 0.5 };
+    auto Jb = mathlib::calculus::jacobian_forward_banded(F, x, F(x), 1, 1);
+    auto Jd = mathlib::calculus::jacobian_forward(F, x, F(x));
+    for (std::size_t i = 0; i < 25; ++i) EXPECT_DOUBLE_EQ(Jb.a[i], Jd.a[i]);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include "mathlib/ode/symplectic.hpp"
+#include "mathlib/ode/solvers.hpp"
+
+namespace {
+
+    using V2 = mathlib::linalg::Vector<2, double>;
+    using mathlib::ode::PhaseState;
+
+    // Kepler problem (GM = 1), returns the acceleration
+    V2 kepler(const V2& q) {
+        const double r = std::sqrt(q[0] * q[0] + q[1] * q[1]);
+        return (-1.0 / (r * r * r)) * q;
+    }
+
+    double kepler_energy(const V2& q, const V2& p) {
+        return 0.5 * (p[0] * p[0] + p[1] * p[1]) - 1.0 / std::sqrt(q[0] * q[0] + q[1] * q[1]);
+    }
+
+    // Eccentricity 0.5 orbit starting at perihelion, period 2 pi
+    PhaseState<V2> kepler_start() {
+        const double e = 0.5;
+        return { V2{ 1.0 - e, 0.0 }, V2{ 0.0, std::sqrt((1.0 + e) / (1.0 - e)) } };
+    }
+
+    template <typename Method>
+    double oscillator_error(const Method& m, double h) {
+        auto force = [](double q) { return -q; };
+        const auto [t, y] = mathlib::ode::solve_symplectic(m, force, 0.0, PhaseState<double>{ 1.0, 0.0 }, 2.0, h,
+            [](double, const PhaseState<double>&) {});
+        return std::abs(y.q - std::cos(t));
+    }
+
+} // namespace
+
+TEST(Symplectic, ConvergenceOrders) {
+    auto order = [](const auto& m, double h) {
+        return std::log2(oscillator_error(m, h) / oscillator_error(m, h / 2));
+    };
+    EXPECT_NEAR(order(mathlib::ode::velocity_verlet<double>(), 0.02), 2.0, 0.1);
+    EXPECT_NEAR(order(mathlib::ode::yoshida4<double>(), 0.05), 4.0, 0.2);
+    EXPECT_NEAR(order(mathlib::ode::forest_ruth<double>(), 0.05), 4.0, 0.2);
+    EXPECT_NEAR(order(mathlib::ode::yoshida6<double>(), 0.2), 6.0, 0.4);
+}
+
+TEST(Symplectic, ForceEvaluationsReuseLastKick) {
+    auto count = [](const auto& m) {
+        mathlib::ode::SymplecticStats st;
+        mathlib::ode::solve_symplectic(m, [](double q) { return -q; }, 0.0, PhaseState<double>{ 1.0, 0.0 },
+            1.0, 0.01, [](double, const PhaseState<double>&) {}, &st);
+        EXPECT_EQ(st.steps, 100u);
+        return st.force_evals;
+    };
+    EXPECT_EQ(count(mathlib::ode::velocity_verlet<double>()), 101u);
+    EXPECT_EQ(count(mathlib::ode::yoshida4<double>()), 301u);
+    EXPECT_EQ(count(mathlib::ode::yoshida6<double>()), 701u);
+    EXPECT_EQ(count(mathlib::ode::forest_ruth<double>()), 300u);
+}
+
+TEST(Symplectic, KeplerEnergyStaysBoundedWhereRk4Drifts) {
+    const auto y0 = kepler_start();
+    const double e0 = kepler_energy(y0.q, y0.p);
+    const double h = 0.05, t1 = 200 * 2 * M_PI;
+
+    double verlet_max = 0.0;
+    mathlib::ode::solve_symplectic(mathlib::ode::velocity_verlet<double>(), kepler, 0.0, y0, t1, h,
+        [&](double, const PhaseState<V2>& y) { verlet_max = std::max(verlet_max, std::abs(kepler_energy(y.q, y.p) - e0)); });
+
+    double y4_max = 0.0;
+    mathlib::ode::solve_symplectic(mathlib::ode::yoshida4<double>(), kepler, 0.0, y0, t1, h,
+        [&](double, const PhaseState<V2>& y) { y4_max = std::max(y4_max, std::abs(kepler_energy(y.q, y.p) - e0)); });
+
+    using V4 = mathlib::linalg::Vector<4, double>;
+    auto f = [](double, const V4& y) {
+        const V2 a = kepler(V2{ y[0], y[1] });
+        return V4{ y[2], y[3], a[0], a[1] };
+    };
+    const auto [t, y] = mathlib::ode::solve_rk4(f, 0.0, V4{ y0.q[0], y0.q[1], y0.p[0], y0.p[1] }, t1, h,
+        [](double, const V4&) {});
+    const double rk4_drift = std::abs(kepler_energy(V2{ y[0], y[1] }, V2{ y[2], y[3] }) - e0);
+
+    EXPECT_LT(verlet_max, 5e-3);
+    EXPECT_LT(y4_max, 1e-4);
+    EXPECT_GT(rk4_drift, 10 * y4_max);
+}
+
+TEST(Symplectic, InPlaceSoAParticles) {
+    // 1000 uncoupled oscillators in flat arrays, in-place force
+    const std::size_t n = 1000;
+    PhaseState<std::vector<double>> y{ std::vector<double>(n), std::vector<double>(n, 0.0) };
+    for (std::size_t i = 0; i < n; ++i) y.q[i] = 1.0 + static_cast<double>(i) / n;
+
+    auto force = [](const std::vector<double>& q, std::vector<double>& a) {
+        for (std::size_t i = 0; i < q.size(); ++i) a[i] = -q[i];
+    };
+    mathlib::ode::SymplecticStepper stepper(force, mathlib::ode::yoshida4<double>(), y.q);
+    const double* q_data = y.q.data();
+    for (int k = 0; k < 100; ++k) stepper.step(y, 0.01);
+
+    EXPECT_EQ(y.q.data(), q_data);
+    EXPECT_EQ(stepper.stats().force_evals, 301u);
+    for (std::size_t i = 0; i < n; i += 97) {
+        EXPECT_NEAR(y.q[i], (1.0 + static_cast<double>(i) / n) * std::cos(1.0), 1e-8);
+    }
+}
+
+TEST(Symplectic, RejectsBadArguments) {
+    auto force = [](double q) { return -q; };
+    EXPECT_THROW(mathlib::ode::solve_symplectic(mathlib::ode::velocity_verlet<double>(), force, 0.0,
+        PhaseState<double>{ 1.0, 0.0 }, 1.0, 0.0), mathlib::core::domain_error);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "mathlib/ode/trajectory_file.hpp"
+#include "mathlib/ode/solvers.hpp"
+
+namespace {
+
+    using V2 = mathlib::linalg::Vector<2, double>;
+
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    V2 oscillator(double, const V2& y) { return V2{ y[1], -y[0] }; }
+
+} // namespace
+
+TEST(TrajectoryFile, SolverSinkRoundTrip) {
+    const std::string path = temp_path("mathlib_traj_roundtrip.bin");
+    const auto ref = mathlib::ode::solve_rk4(oscillator, 0.0, V2{ 1.0, 0.0 }, 10.0, 1e-3);
+
+    {
+        mathlib::ode::TrajectoryWriter<V2, double> writer(path, { 1000, true });
+        mathlib::ode::solve_rk4(oscillator, 0.0, V2{ 1.0, 0.0 }, 10.0, 1e-3, writer);
+        writer.close();
+        EXPECT_EQ(writer.samples(), ref.size());
+    }
+
+    mathlib::ode::TrajectoryReader<V2, double> reader(path);
+    ASSERT_EQ(reader.size(), ref.size());
+    EXPECT_EQ(reader.chunks(), (ref.size() + 999) / 1000);
+    for (std::size_t i = 0; i < ref.size(); i += 613) {
+        EXPECT_EQ(reader.time(i), ref[i].first);
+        const V2 y = reader.state(i);
+        EXPECT_EQ(y[0], ref[i].second[0]);
+        EXPECT_EQ(reader.component(i, 1), ref[i].second[1]);
+    }
+    // past the last sample, but inside the last chunk's capacity
+    EXPECT_THROW((void)reader.time(ref.size()), mathlib::core::domain_error);
+    EXPECT_THROW((void)reader.state(ref.size()), mathlib::core::domain_error);
+    EXPECT_THROW((void)reader.component(ref.size(), 0), mathlib::core::domain_error);
+    EXPECT_THROW((void)reader.component(0, 2), mathlib::core::domain_error);
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryFile, WindowAndChunkIndex) {
+    const std::string path = temp_path("mathlib_traj_window.bin");
+    {
+        mathlib::ode::TrajectoryWriter<double, double> writer(path, { 64, true });
+        for (int i = 0; i < 1000; ++i) writer(0.5 * i, std::sin(0.01 * i));
+    }
+
+    mathlib::ode::TrajectoryReader<double, double> reader(path);
+    ASSERT_EQ(reader.size(), 1000u);
+    ASSERT_TRUE(reader.indexed());
+
+    const auto [first, last] = reader.window(100.0, 200.25);
+    EXPECT_EQ(first, 200u);
+    EXPECT_EQ(last, 401u);
+    EXPECT_EQ(reader.window(-5.0, -1.0).second, 0u);
+    EXPECT_EQ(reader.window(1e6, 2e6).first, 1000u);
+
+    // per-chunk bounds match the stored column
+    for (std::size_t k = 0; k < reader.chunks(); ++k) {
+        const auto c = reader.chunk(k);
+        const auto col = c.component(0);
+        EXPECT_EQ(c.min(0), *std::min_element(col.begin(), col.end()));
+        EXPECT_EQ(c.max(0), *std::max_element(col.begin(), col.end()));
+    }
+    EXPECT_EQ(reader.chunk(reader.chunks() - 1).size(), 1000u % 64);
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryFile, RejectsMismatchedSchemaAndBadInput) {
+    const std::string path = temp_path("mathlib_traj_schema.bin");
+    {
+        mathlib::ode::TrajectoryWriter<V2, float> writer(path);
+        writer(0.0f, V2{});
+        EXPECT_THROW(writer(-1.0f, V2{}), mathlib::core::domain_error);
+    }
+    EXPECT_THROW((mathlib::ode::TrajectoryReader<V2, double>(path)), mathlib::core::dimension_error);
+    EXPECT_THROW((mathlib::ode::TrajectoryReader<double, float>(path)), mathlib::core::dimension_error);
+    EXPECT_EQ((mathlib::ode::TrajectoryReader<mathlib::linalg::Vector<2, float>, float>(path).size()), 1u);
+    EXPECT_THROW((mathlib::ode::TrajectoryReader<double, double>(temp_path("mathlib_traj_missing.bin"))),
+        mathlib::core::io_error);
+    std::remove(path.c_str());
+}